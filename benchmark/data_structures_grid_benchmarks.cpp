@@ -0,0 +1,208 @@
+/// @file data_structures_grid_benchmarks.cpp
+/// @brief Benchmarks of commonlib::Grid and actors hot paths, parameterized over the grid side
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include <algorithms/components.h>
+#include <benchmark/benchmark.h>
+#include <data_structures/actor_store.h>
+#include <data_structures/grid.h>
+
+using namespace commonlib;
+
+// Square grids of side 64, 256 and 1024
+static void Sides(benchmark::internal::Benchmark* bench)
+{
+    bench->RangeMultiplier(4)->Range(64, 1024)->ArgName("side");
+}
+
+// One wall every 7 cells, empty elsewhere
+static Grid MakeGrid(const std::size_t side)
+{
+    Grid grid(side, side, '.');
+    for (std::size_t cell{0U}; cell < side * side; cell += 7U)
+        grid(cell / side, cell % side) = '#';
+    grid.AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+    grid.AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+    return grid;
+}
+
+static void BM_GridIndexing(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    Grid grid{MakeGrid(side)};
+    grid.MakeInfinite(state.range(1) != 0);
+    const Grid& view = grid;
+    const std::size_t offset{grid.IsInfinite() ? side : 0U};  // Infinite grids are read one period away
+    for (auto _ : state)
+    {
+        std::size_t walls{0U};
+        for (std::size_t r{0U}; r < side; ++r)
+            for (std::size_t c{0U}; c < side; ++c)
+                walls += (view(r + offset, c) == '#');
+        benchmark::DoNotOptimize(walls);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+// Reads through the non-const operator(), with the change tracking and all the indexes enabled (indexes:1) or not
+static void BM_GridMutableReads(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    Grid grid{MakeGrid(side)};
+    if (state.range(1) != 0)
+    {
+        grid.TrackChanges(true);
+        grid.MaterializeTiles(true);
+        grid.IndexValues({'#'});
+        grid.EnableHashing(true);
+    }
+    for (auto _ : state)
+    {
+        std::size_t walls{0U};
+        for (std::size_t r{0U}; r < side; ++r)
+            for (std::size_t c{0U}; c < side; ++c)
+                walls += (grid(r, c) == '#');
+        benchmark::DoNotOptimize(walls);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+static void BM_GridTileTypes(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Grid grid{MakeGrid(side)};
+    for (auto _ : state)
+    {
+        std::size_t walls{0U};
+        for (std::size_t r{0U}; r < side; ++r)
+            for (std::size_t c{0U}; c < side; ++c)
+                walls += (grid.GetTileType(r, c) == TileType::kTileType_Wall);
+        benchmark::DoNotOptimize(walls);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+static void BM_GridCountElements(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Grid grid{MakeGrid(side)};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(grid.CountElements('#'));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+// Walls in a 16x16 rectangle: scan against the per-value prefix counts
+static void BM_GridCountInRectangle(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    Grid grid{MakeGrid(side)};
+    if (state.range(1) != 0) grid.IndexValues({'#'});
+    std::size_t cell{0U};
+    for (auto _ : state)
+    {
+        cell = (cell + 7919U) % (side * side);
+        benchmark::DoNotOptimize(grid.CountInRectangle('#', cell / side, cell % side, cell / side + 15U, cell % side + 15U));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// Wall components of the grid, on the calling thread (threads:0) or on a pool
+static void BM_GridLabelComponents(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Grid grid{MakeGrid(side)};
+    ThreadPool pool(static_cast<std::size_t>(std::max<std::int64_t>(state.range(1), 1)));
+    for (auto _ : state)
+    {
+        const Components walls =
+            LabelComponents(grid, '#', Connectivity::kEight, (state.range(1) != 0) ? &pool : nullptr);
+        benchmark::DoNotOptimize(walls.Size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+// Hash after 16 writes: full rehash (hashing:0) against the incremental Zobrist hash
+static void BM_GridHash(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    Grid grid{MakeGrid(side)};
+    grid.EnableHashing(state.range(1) != 0);
+    std::size_t cell{0U};
+    for (auto _ : state)
+    {
+        for (std::size_t write{0U}; write < 16U; ++write)
+        {
+            cell = (cell + 7919U) % (side * side);
+            grid(cell / side, cell % side) = (grid(cell / side, cell % side) == '#') ? '.' : '#';
+        }
+        benchmark::DoNotOptimize(grid.Hash());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_GridMoveActors(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    Grid grid{MakeGrid(side)};
+    const std::size_t n_actors{side};
+    for (std::size_t id{0U}; id < n_actors; ++id)
+        grid.AddActor(Actor(id, 'a', Position<std::size_t>(id, id)));
+    std::size_t step{0U};
+    for (auto _ : state)
+    {
+        ++step;
+        for (std::size_t id{0U}; id < n_actors; ++id)
+            grid.MoveActor(id, Position<std::size_t>((id + step) % side, id));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n_actors));
+}
+
+static void BM_GridActorsInRadius(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    Grid grid{MakeGrid(side)};
+    for (std::size_t id{0U}; id < side * 4U; ++id)
+        grid.AddActor(Actor(id, 'a', Position<std::size_t>((id * 37U) % side, (id * 91U) % side)));
+    std::size_t cell{0U};
+    for (auto _ : state)
+    {
+        cell = (cell + 7919U) % (side * side);
+        benchmark::DoNotOptimize(grid.ActorsInRadius(cell / side, cell % side, 8.0));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_ActorStoreApplyVelocity(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Grid grid{MakeGrid(side)};
+    ActorStore<long> actors;
+    const std::size_t n_actors{side * 16U};
+    actors.Reserve(n_actors);
+    for (std::size_t id{0U}; id < n_actors; ++id)
+    {
+        actors.Add(id, 'a', Position<long>(static_cast<long>(id % side), static_cast<long>((id / side) % side)),
+                   Position<long>(1, 0));
+    }
+    for (auto _ : state)
+    {
+        benchmark::DoNotOptimize(actors.ApplyVelocity(grid));
+        for (const std::size_t id : actors.Ids())
+            actors.SetVelocity(id, Position<long>(1, 0));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(n_actors));
+}
+
+BENCHMARK(BM_GridIndexing)->ArgsProduct({{64, 256, 1024}, {0, 1}})->ArgNames({"side", "infinite"});
+BENCHMARK(BM_GridMutableReads)->ArgsProduct({{64, 256, 1024}, {0, 1}})->ArgNames({"side", "indexes"});
+BENCHMARK(BM_GridTileTypes)->Apply(Sides);
+BENCHMARK(BM_GridCountElements)->Apply(Sides);
+BENCHMARK(BM_GridCountInRectangle)->ArgsProduct({{64, 256, 1024}, {0, 1}})->ArgNames({"side", "indexed"});
+BENCHMARK(BM_GridLabelComponents)->ArgsProduct({{256, 1024}, {0, 4}})->ArgNames({"side", "threads"});
+BENCHMARK(BM_GridHash)->ArgsProduct({{64, 256, 1024}, {0, 1}})->ArgNames({"side", "hashing"});
+BENCHMARK(BM_GridMoveActors)->Apply(Sides);
+BENCHMARK(BM_GridActorsInRadius)->Apply(Sides);
+BENCHMARK(BM_ActorStoreApplyVelocity)->Apply(Sides);
@@ -0,0 +1,239 @@
+/// @file data_structures_matrix_benchmarks.cpp
+/// @brief Benchmarks of commonlib::Matrix hot paths, parameterized over the matrix side and the element type
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include <benchmark/benchmark.h>
+#include <data_structures/matrix.h>
+
+using namespace commonlib;
+
+// Square matrices of side 64, 256 and 1024
+static void Sides(benchmark::internal::Benchmark* bench)
+{
+    bench->RangeMultiplier(4)->Range(64, 1024)->ArgName("side");
+}
+
+// Element (r, c) = (r * 31 + c * 17) % 100
+template <typename T>
+static Matrix<T> MakeMatrix(const std::size_t side)
+{
+    Matrix<T> matrix(side, side);
+    for (std::size_t r{0U}; r < side; ++r)
+        for (std::size_t c{0U}; c < side; ++c)
+            matrix(r, c) = static_cast<T>((r * 31U + c * 17U) % 100U);
+    return matrix;
+}
+
+// Same elements, written as comma-separated text
+static std::string WriteTextFile(const std::size_t side)
+{
+    const std::string path{"benchmark_matrix_" + std::to_string(side) + ".txt"};
+    std::ofstream fp(path, std::ios::trunc);
+    for (std::size_t r{0U}; r < side; ++r)
+    {
+        for (std::size_t c{0U}; c < side; ++c)
+            fp << ((r * 31U + c * 17U) % 100U) << ((c + 1U < side) ? ',' : '\n');
+    }
+    return path;
+}
+
+template <typename T>
+static void BM_MatrixConstruction(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    for (auto _ : state)
+    {
+        Matrix<T> matrix(side, side, T{1});
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+template <typename T>
+static void BM_MatrixParseMappedFile(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const std::string path{WriteTextFile(side)};
+    const MappedFile file(path);
+    for (auto _ : state)
+    {
+        Matrix<T> matrix(file);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(file.Size()));
+    std::remove(path.c_str());
+}
+
+template <typename T>
+static void BM_MatrixParseStream(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const std::string path{WriteTextFile(side)};
+    for (auto _ : state)
+    {
+        std::ifstream fp(path);
+        Matrix<T> matrix(fp);
+        benchmark::DoNotOptimize(matrix.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+    std::remove(path.c_str());
+}
+
+template <typename T>
+static void BM_MatrixIndexing(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Matrix<T> matrix{MakeMatrix<T>(side)};
+    for (auto _ : state)
+    {
+        T sum{};
+        for (std::size_t r{0U}; r < side; ++r)
+            for (std::size_t c{0U}; c < side; ++c)
+                sum += matrix(r, c);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+template <typename T>
+static void BM_MatrixUncheckedIndexing(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Matrix<T> matrix{MakeMatrix<T>(side)};
+    for (auto _ : state)
+    {
+        T sum{};
+        for (std::size_t r{0U}; r < side; ++r)
+        {
+            const T* row = matrix[r];
+            for (std::size_t c{0U}; c < side; ++c)
+                sum += row[c];
+        }
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+template <typename T>
+static void BM_MatrixCutWindow(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    Matrix<T> matrix{MakeMatrix<T>(side)};
+    std::size_t cell{0U};
+    for (auto _ : state)
+    {
+        // Walk the cells with a stride coprime with the side, border cells included
+        cell = (cell + 7919U) % (side * side);
+        Matrix<T> window = matrix.CutWindow(cell / side, cell % side, 5U);
+        benchmark::DoNotOptimize(window.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+template <typename T>
+static void BM_MatrixFixedCutWindow(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Matrix<T> matrix{MakeMatrix<T>(side)};
+    std::size_t cell{0U};
+    for (auto _ : state)
+    {
+        cell = (cell + 7919U) % (side * side);
+        const FixedMatrix<T, 5, 5> window = matrix.template CutWindow<5>(cell / side, cell % side);
+        benchmark::DoNotOptimize(window.data());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+// One window per cell: CutWindow on every cell against the sliding traversal
+template <typename T>
+static void BM_MatrixAllCutWindows(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    Matrix<T> matrix{MakeMatrix<T>(side)};
+    for (auto _ : state)
+    {
+        T sum{};
+        for (std::size_t r{0U}; r < side; ++r)
+            for (std::size_t c{0U}; c < side; ++c)
+                sum += matrix.CutWindow(r, c, 3U)(0, 0);
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+template <typename T>
+static void BM_MatrixForEachWindow(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Matrix<T> matrix{MakeMatrix<T>(side)};
+    for (auto _ : state)
+    {
+        T sum{};
+        matrix.ForEachWindow(3U, [&sum](std::size_t, std::size_t, MatrixView<const T> window) { sum += window(0, 0); });
+        benchmark::DoNotOptimize(sum);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+template <typename T>
+static void BM_MatrixCountElements(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Matrix<T> matrix{MakeMatrix<T>(side)};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(matrix.CountElements(T{42}));
+    state.SetBytesProcessed(state.iterations() * static_cast<std::int64_t>(side * side * sizeof(T)));
+}
+
+template <typename T>
+static void BM_MatrixTile(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Matrix<T> matrix{MakeMatrix<T>(side)};
+    for (auto _ : state)
+    {
+        Matrix<T> tiled(matrix);
+        tiled.Tile(2U, 2U);
+        benchmark::DoNotOptimize(tiled.data());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(4U * side * side));
+}
+
+template <typename T>
+static void BM_MatrixEquality(benchmark::State& state)
+{
+    const std::size_t side{static_cast<std::size_t>(state.range(0))};
+    const Matrix<T> lhs{MakeMatrix<T>(side)};
+    const Matrix<T> rhs{MakeMatrix<T>(side)};
+    for (auto _ : state)
+        benchmark::DoNotOptimize(lhs == rhs);
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(side * side));
+}
+
+BENCHMARK_TEMPLATE(BM_MatrixConstruction, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixConstruction, double)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixParseMappedFile, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixParseMappedFile, double)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixParseStream, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixIndexing, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixIndexing, double)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixIndexing, char)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixUncheckedIndexing, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixUncheckedIndexing, char)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixCutWindow, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixCutWindow, char)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixFixedCutWindow, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixFixedCutWindow, char)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixAllCutWindows, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixForEachWindow, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixCountElements, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixCountElements, double)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixCountElements, char)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixTile, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixTile, char)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixEquality, int)->Apply(Sides);
+BENCHMARK_TEMPLATE(BM_MatrixEquality, char)->Apply(Sides);
@@ -0,0 +1,369 @@
+/// @file components.h
+/// @author Alberto Santagostino
+
+#ifndef ALGORITHMS_COMPONENTS_H
+#define ALGORITHMS_COMPONENTS_H
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+#ifdef TEST_BUILD
+#include <data_structures/grid.h>
+#include <data_structures/matrix.h>
+#include <utils/thread_pool.h>
+#else
+#include <commonlib/include/data_structures/grid.h>
+#include <commonlib/include/data_structures/matrix.h>
+#include <commonlib/include/utils/thread_pool.h>
+#endif
+
+namespace commonlib
+{
+/// @brief Cells considered adjacent when growing a region
+enum class Connectivity
+{
+    kFour,  ///< Cells sharing a side
+    kEight  ///< Cells sharing a side or a corner
+};
+
+/// @brief Connected region of a Grid
+struct Component
+{
+    std::uint32_t label{0U};  ///< Label of the cells of the component in Components::labels
+    char value{'\0'};         ///< Character of the first cell of the component (in row-major order)
+    std::size_t size{0U};     ///< Number of cells
+    std::size_t first_row{0U};  ///< Bounding box (bounds included)
+    std::size_t first_col{0U};
+    std::size_t last_row{0U};
+    std::size_t last_col{0U};
+};
+
+/// @brief Connected components of a Grid, see LabelComponents()
+struct Components
+{
+    Matrix<std::uint32_t> labels;       ///< Label of every cell, 0 for the cells not selected
+    std::vector<Component> components;  ///< Component with label l is components[l - 1], labels follow row-major order
+
+    Components(const std::size_t n_rows, const std::size_t n_cols) : labels(n_rows, n_cols, 0U) {}
+
+    inline std::size_t Size() const { return components.size(); }
+    /// @brief Component of a cell
+    /// @throw std::out_of_range If the cell does not exist or does not belong to any component
+    inline const Component& At(const std::size_t row, const std::size_t col) const
+    {
+        const std::uint32_t label{labels(row, col)};
+        if (label == 0U) throw std::out_of_range("Components::At(row, col): The cell does not belong to any component");
+        return components[label - 1U];
+    }
+};
+
+namespace detail
+{
+/// @class ComponentLabeler
+/// @brief Two-pass union-find labeler: each band of rows is labeled independently (on the pool if any), the bands
+///        are merged along their borders, then every cell gets the compact label of its root
+/// @details Roots always are the smallest linear index of their set, so parent[i] <= i and the roots are the first
+///          cells of their component in row-major order. Cells connect when their keys are equal and not negative
+class ComponentLabeler
+{
+  public:
+    ComponentLabeler(const Grid& grid, const std::array<int, 256U>& keys, const Connectivity connectivity,
+                     ThreadPool* pool)
+        : m_grid(grid), m_keys(keys), m_eight(connectivity == Connectivity::kEight), m_pool(pool),
+          m_rows(grid.NRows()), m_cols(grid.NCols())
+    {
+    }
+
+    Components Run();
+
+  private:
+    static constexpr std::uint32_t kExcluded{std::numeric_limits<std::uint32_t>::max()};
+
+    const Grid& m_grid;
+    const std::array<int, 256U>& m_keys;
+    const bool m_eight;
+    ThreadPool* m_pool;
+    const std::size_t m_rows;
+    const std::size_t m_cols;
+    std::vector<std::uint32_t> m_parent;
+
+    inline int m_Key(const std::size_t row, const std::size_t col) const
+    {
+        return m_keys[static_cast<unsigned char>(m_grid[row][col])];
+    }
+    std::uint32_t m_Find(std::uint32_t cell);
+    std::uint32_t m_Root(std::uint32_t cell) const;
+    void m_Union(const std::uint32_t a, const std::uint32_t b);
+    void m_ConnectUp(const std::size_t row, const std::size_t col, const int key);
+    void m_LabelBand(const std::size_t first_row, const std::size_t last_row);
+    template <typename Work>
+    void m_ForBands(const std::vector<std::size_t>& bounds, Work work);
+};
+
+/// @brief Root of a cell, halving the path on the way
+inline std::uint32_t ComponentLabeler::m_Find(std::uint32_t cell)
+{
+    while (m_parent[cell] != cell)
+    {
+        m_parent[cell] = m_parent[m_parent[cell]];
+        cell = m_parent[cell];
+    }
+    return cell;
+}
+
+/// @brief Root of a cell, without modifying the forest (safe to call from several threads)
+inline std::uint32_t ComponentLabeler::m_Root(std::uint32_t cell) const
+{
+    while (m_parent[cell] != cell)
+        cell = m_parent[cell];
+    return cell;
+}
+
+/// @brief Merge the sets of two cells, the smaller root becomes the root of both
+inline void ComponentLabeler::m_Union(const std::uint32_t a, const std::uint32_t b)
+{
+    const std::uint32_t root_a{m_Find(a)};
+    const std::uint32_t root_b{m_Find(b)};
+    if (root_a < root_b)
+        m_parent[root_b] = root_a;
+    else if (root_b < root_a)
+        m_parent[root_a] = root_b;
+}
+
+/// @brief Connect a cell with its neighbours in the previous row
+inline void ComponentLabeler::m_ConnectUp(const std::size_t row, const std::size_t col, const int key)
+{
+    const std::uint32_t cell{static_cast<std::uint32_t>(row * m_cols + col)};
+    const std::uint32_t up{static_cast<std::uint32_t>(cell - m_cols)};
+    if (m_Key(row - 1U, col) == key) m_Union(cell, up);
+    if (!m_eight) return;
+    if ((col > 0U) && (m_Key(row - 1U, col - 1U) == key)) m_Union(cell, up - 1U);
+    if ((col + 1U < m_cols) && (m_Key(row - 1U, col + 1U) == key)) m_Union(cell, up + 1U);
+}
+
+/// @brief First pass on rows [first_row, last_row): only the cells of the band are connected
+inline void ComponentLabeler::m_LabelBand(const std::size_t first_row, const std::size_t last_row)
+{
+    for (std::size_t row{first_row}; row < last_row; ++row)
+    {
+        for (std::size_t col{0U}; col < m_cols; ++col)
+        {
+            const std::uint32_t cell{static_cast<std::uint32_t>(row * m_cols + col)};
+            const int key{m_Key(row, col)};
+            if (key < 0)
+            {
+                m_parent[cell] = kExcluded;
+                continue;
+            }
+            m_parent[cell] = cell;
+            if ((col > 0U) && (m_Key(row, col - 1U) == key)) m_Union(cell, cell - 1U);
+            if (row > first_row) m_ConnectUp(row, col, key);
+        }
+    }
+}
+
+/// @brief Run work(band, first_row, last_row) on every band (on the pool if any)
+template <typename Work>
+void ComponentLabeler::m_ForBands(const std::vector<std::size_t>& bounds, Work work)
+{
+    const std::size_t n_bands{bounds.size() - 1U};
+    if (n_bands == 1U)
+    {
+        work(std::size_t{0U}, bounds[0], bounds[1]);
+        return;
+    }
+    m_pool->ParallelFor(n_bands, [&work, &bounds](std::size_t band) { work(band, bounds[band], bounds[band + 1U]); });
+}
+
+/// @brief Label the grid
+inline Components ComponentLabeler::Run()
+{
+    if ((m_rows == 0U) || (m_cols == 0U)) throw std::length_error("LabelComponents(): The grid is empty");
+    if (m_rows * m_cols >= std::size_t{kExcluded})
+        throw std::length_error("LabelComponents(): The grid has too many cells");
+    Components result(m_rows, m_cols);
+    m_parent.resize(m_rows * m_cols);
+
+    // Bands of rows: one on the calling thread, twice the workers on a pool
+    std::size_t n_bands{1U};
+    if ((m_pool != nullptr) && (m_pool->Size() > 1U)) n_bands = std::min(m_rows, m_pool->Size() * 2U);
+    std::vector<std::size_t> bounds(n_bands + 1U);
+    for (std::size_t band{0U}; band <= n_bands; ++band)
+        bounds[band] = band * m_rows / n_bands;
+
+    // First pass: union-find inside every band, then across the borders of the bands
+    m_ForBands(bounds, [this](std::size_t, std::size_t first_row, std::size_t last_row) {
+        m_LabelBand(first_row, last_row);
+    });
+    for (std::size_t band{1U}; band < n_bands; ++band)
+    {
+        const std::size_t row{bounds[band]};
+        for (std::size_t col{0U}; col < m_cols; ++col)
+        {
+            const int key{m_Key(row, col)};
+            if (key >= 0) m_ConnectUp(row, col, key);
+        }
+    }
+
+    // Second pass: number the roots in row-major order, then give every cell the label of its root
+    std::vector<std::uint32_t> n_roots(n_bands + 1U, 0U);
+    m_ForBands(bounds, [this, &n_roots](std::size_t band, std::size_t first_row, std::size_t last_row) {
+        std::uint32_t count{0U};
+        for (std::size_t cell{first_row * m_cols}; cell < last_row * m_cols; ++cell)
+            count += static_cast<std::uint32_t>(m_parent[cell] == cell);
+        n_roots[band + 1U] = count;
+    });
+    for (std::size_t band{0U}; band < n_bands; ++band)
+        n_roots[band + 1U] += n_roots[band];
+    m_ForBands(bounds, [this, &n_roots, &result](std::size_t band, std::size_t first_row, std::size_t last_row) {
+        std::uint32_t label{n_roots[band]};
+        for (std::size_t row{first_row}; row < last_row; ++row)
+        {
+            std::uint32_t* labels = result.labels[row];
+            for (std::size_t col{0U}; col < m_cols; ++col)
+            {
+                const std::uint32_t cell{static_cast<std::uint32_t>(row * m_cols + col)};
+                if (m_parent[cell] == cell) labels[col] = ++label;
+            }
+        }
+    });
+    m_ForBands(bounds, [this, &result](std::size_t, std::size_t first_row, std::size_t last_row) {
+        for (std::size_t row{first_row}; row < last_row; ++row)
+        {
+            std::uint32_t* labels = result.labels[row];
+            for (std::size_t col{0U}; col < m_cols; ++col)
+            {
+                const std::uint32_t cell{static_cast<std::uint32_t>(row * m_cols + col)};
+                if ((m_parent[cell] != kExcluded) && (m_parent[cell] != cell))
+                {
+                    const std::uint32_t root{m_Root(cell)};
+                    labels[col] = result.labels[root / m_cols][root % m_cols];
+                }
+            }
+        }
+    });
+
+    // Sizes and bounding boxes
+    result.components.resize(n_roots[n_bands]);
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        const std::uint32_t* labels = result.labels[row];
+        for (std::size_t col{0U}; col < m_cols; ++col)
+        {
+            if (labels[col] == 0U) continue;
+            Component& component = result.components[labels[col] - 1U];
+            if (component.size++ == 0U)
+            {
+                component.label = labels[col];
+                component.value = m_grid[row][col];
+                component.first_row = component.last_row = row;
+                component.first_col = component.last_col = col;
+            }
+            else
+            {
+                component.last_row = row;
+                component.first_col = std::min(component.first_col, col);
+                component.last_col = std::max(component.last_col, col);
+            }
+        }
+    }
+    return result;
+}
+
+}  // namespace detail
+
+/// @brief Label the connected regions of cells with the same character
+/// @param connectivity Adjacency of the cells
+/// @param pool Thread pool to split the rows on (nullptr to run on the calling thread)
+/// @details Infinite grids are labeled as finite ones (regions do not wrap around the borders)
+/// @throw std::length_error If the grid is empty or has 2^32 - 1 cells or more
+inline Components LabelComponents(const Grid& grid,
+                                  const Connectivity connectivity = Connectivity::kFour,
+                                  ThreadPool* pool = nullptr)
+{
+    std::array<int, 256U> keys;
+    for (std::size_t c{0U}; c < keys.size(); ++c)
+        keys[c] = static_cast<int>(c);
+    return detail::ComponentLabeler(grid, keys, connectivity, pool).Run();
+}
+
+/// @brief Label the connected regions of the cells equal to a character, the other cells get label 0
+/// @throw std::length_error If the grid is empty or has 2^32 - 1 cells or more
+inline Components LabelComponents(const Grid& grid,
+                                  const char value,
+                                  const Connectivity connectivity = Connectivity::kFour,
+                                  ThreadPool* pool = nullptr)
+{
+    std::array<int, 256U> keys;
+    keys.fill(-1);
+    keys[static_cast<unsigned char>(value)] = 0;
+    return detail::ComponentLabeler(grid, keys, connectivity, pool).Run();
+}
+
+/// @brief Label the connected regions of the cells of a tile type, the other cells get label 0
+/// @throw std::length_error If the grid is empty or has 2^32 - 1 cells or more
+inline Components LabelComponents(const Grid& grid,
+                                  const TileType tiletype,
+                                  const Connectivity connectivity = Connectivity::kFour,
+                                  ThreadPool* pool = nullptr)
+{
+    std::array<int, 256U> keys;
+    for (std::size_t c{0U}; c < keys.size(); ++c)
+        keys[c] = (grid.GetTileType(static_cast<char>(c)) == tiletype) ? 0 : -1;
+    return detail::ComponentLabeler(grid, keys, connectivity, pool).Run();
+}
+
+/// @brief Replace the region of cells with the same character as (row, col) with another character
+/// @details Iterative (explicit stack, no recursion). Cells are written through Grid::operator(), so change tracking
+///          and the grid indexes see them. Infinite grids are filled as finite ones
+/// @return Number of cells written (0 if the cell already has the new value)
+/// @throw std::out_of_range If the cell does not exist
+inline std::size_t FloodFill(Grid& grid,
+                             const std::size_t row,
+                             const std::size_t col,
+                             const char value,
+                             const Connectivity connectivity = Connectivity::kFour)
+{
+    const std::size_t n_rows{grid.NRows()};
+    const std::size_t n_cols{grid.NCols()};
+    if ((row >= n_rows) || (col >= n_cols))
+        throw std::out_of_range("FloodFill(grid, row, col, value): Index is out of range");
+    const char old_value{grid[row][col]};
+    if (old_value == value) return 0U;
+
+    // Cells are written when pushed, so they are never pushed twice
+    std::size_t filled{0U};
+    std::vector<std::size_t> stack{row * n_cols + col};
+    grid(row, col) = value;
+    while (!stack.empty())
+    {
+        const std::size_t r{stack.back() / n_cols};
+        const std::size_t c{stack.back() % n_cols};
+        stack.pop_back();
+        ++filled;
+        const std::size_t r0{(r > 0U) ? r - 1U : r};
+        const std::size_t r1{std::min(r + 1U, n_rows - 1U)};
+        const std::size_t c0{(c > 0U) ? c - 1U : c};
+        const std::size_t c1{std::min(c + 1U, n_cols - 1U)};
+        for (std::size_t nr{r0}; nr <= r1; ++nr)
+        {
+            for (std::size_t nc{c0}; nc <= c1; ++nc)
+            {
+                if ((connectivity == Connectivity::kFour) && (nr != r) && (nc != c)) continue;
+                if (grid[nr][nc] != old_value) continue;
+                grid(nr, nc) = value;
+                stack.push_back(nr * n_cols + nc);
+            }
+        }
+    }
+    return filled;
+}
+
+}  // namespace commonlib
+
+#endif  // ALGORITHMS_COMPONENTS_H
@@ -0,0 +1,548 @@
+/// @file pathfinding.h
+/// @author Alberto Santagostino
+
+#ifndef ALGORITHMS_PATHFINDING_H
+#define ALGORITHMS_PATHFINDING_H
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef TEST_BUILD
+#include <data_structures/grid.h>
+#include <data_structures/matrix.h>
+#include <primitives/position.h>
+#else
+#include <commonlib/include/data_structures/grid.h>
+#include <commonlib/include/data_structures/matrix.h>
+#include <commonlib/include/primitives/position.h>
+#endif
+
+namespace commonlib
+{
+/// @brief Search algorithm used by a Pathfinder query
+enum class PathAlgorithm
+{
+    kBfs,       ///< Unit cost per move, tile costs are ignored
+    kDijkstra,  ///< Tile costs, no heuristic
+    kAStar,     ///< Tile costs, octile (manhattan without diagonals) heuristic
+    kJumpPoint  ///< A* over jump points: uniform costs and diagonal moves only, kAStar is used otherwise
+};
+
+/// @brief Cost of moving onto each tile type, a missing (or 0/infinite) cost makes the tile type not walkable
+typedef std::unordered_map<TileType, double> TileCosts;
+
+/// @brief Path found by a Pathfinder query
+struct Path
+{
+    std::vector<Position<std::size_t>> cells;  ///< From the source to the target, both included
+    double cost{0.0};                          ///< Sum of the move costs (number of moves for kBfs)
+};
+
+/// @class Pathfinder
+/// @brief Shortest paths on a Grid, cells are Position(x = column, y = row)
+/// @details The walkability and costs of the grid are copied at construction in a flat array, so the grid can be
+///          modified (or destroyed) afterwards without affecting the pathfinder. All the per-query state (distances,
+///          parents, visited flags, queues) lives in flat arrays reused by every query: they are invalidated by
+///          bumping a generation counter instead of being cleared, so a query only touches the cells it visits.
+///          Moving onto a cell costs the cell cost (times sqrt(2) for diagonal moves); diagonal moves never cut the
+///          corner of a non-walkable cell. A Pathfinder is not thread-safe, use one per thread
+class Pathfinder
+{
+  public:
+    // Constructors
+    explicit Pathfinder(const Grid& grid, const TileCosts& costs = {{TileType::kTileType_Empty, 1.0}},
+                        const bool diagonals = false);
+
+    // Queries
+    std::optional<Path> FindPath(const Position<std::size_t>& source, const Position<std::size_t>& target,
+                                 const PathAlgorithm algorithm = PathAlgorithm::kAStar);
+    std::optional<Path> FindPath(const std::vector<Position<std::size_t>>& sources,
+                                 const std::vector<Position<std::size_t>>& targets,
+                                 const PathAlgorithm algorithm = PathAlgorithm::kAStar);
+    Matrix<double> Distances(const std::vector<Position<std::size_t>>& sources,
+                             const PathAlgorithm algorithm = PathAlgorithm::kDijkstra);
+
+    // Getters
+    inline std::size_t NRows() const { return m_rows; }
+    inline std::size_t NCols() const { return m_cols; }
+    inline bool AllowsDiagonals() const { return m_diagonals; }
+    inline bool IsWalkable(const Position<std::size_t>& cell) const { return m_Walkable(long(cell.y), long(cell.x)); }
+    inline std::size_t ExpandedNodes() const { return m_expanded; }  ///< Cells expanded by the last query
+
+  private:
+    static constexpr std::uint32_t kNone{std::numeric_limits<std::uint32_t>::max()};
+    static constexpr double kSqrt2{1.41421356237309504880};
+    typedef std::pair<double, std::uint32_t> HeapEntry;  ///< (priority, cell)
+
+    std::size_t m_rows;
+    std::size_t m_cols;
+    bool m_diagonals;
+    std::vector<double> m_cost;  ///< Per cell, 0 if not walkable
+    double m_min_cost{0.0};      ///< Lowest walkable cost (scales the heuristic)
+    bool m_uniform{true};        ///< All walkable cells have the same cost
+
+    // Scratch, valid for a cell only if its stamp is the current generation
+    std::uint32_t m_generation{0U};
+    std::vector<std::uint32_t> m_seen;    ///< m_dist and m_parent are valid
+    std::vector<std::uint32_t> m_closed;  ///< Expanded
+    std::vector<std::uint32_t> m_target;  ///< Target of the current query
+    std::vector<double> m_dist;
+    std::vector<std::uint32_t> m_parent;
+    std::vector<std::uint32_t> m_queue;
+    std::vector<HeapEntry> m_heap;
+    std::vector<std::pair<long, long>> m_targets;  ///< (row, col) of the targets of the current query
+    std::size_t m_expanded{0U};
+
+    inline std::uint32_t m_Index(const long row, const long col) const
+    {
+        return static_cast<std::uint32_t>(static_cast<std::size_t>(row) * m_cols + static_cast<std::size_t>(col));
+    }
+    inline bool m_Walkable(const long row, const long col) const
+    {
+        return (row >= 0) && (col >= 0) && (row < long(m_rows)) && (col < long(m_cols)) &&
+               (m_cost[m_Index(row, col)] > 0.0);
+    }
+    inline bool m_IsTarget(const std::uint32_t cell) const { return m_target[cell] == m_generation; }
+
+    std::uint32_t m_Begin(const std::vector<Position<std::size_t>>& sources,
+                          const std::vector<Position<std::size_t>>& targets);
+    void m_Seed(const std::uint32_t cell, const double dist, const std::uint32_t parent, const double priority);
+    double m_Heuristic(const std::uint32_t cell) const;
+    double m_Octile(const long d_row, const long d_col) const;
+    template <typename F>
+    void m_ForEachNeighbour(const std::uint32_t cell, F&& callback) const;
+    std::uint32_t m_Bfs();
+    std::uint32_t m_BestFirst(const bool use_heuristic);
+    std::uint32_t m_JumpPointSearch();
+    std::uint32_t m_Jump(long row, long col, const long d_row, const long d_col) const;
+    std::uint32_t m_JumpStraight(long row, long col, const long d_row, const long d_col) const;
+    Path m_Reconstruct(const std::uint32_t target) const;
+};
+
+/// @brief Constructor: copy the walkability and costs of the grid
+/// @param grid Grid to search, its tile types are resolved through its tile definitions (AddTileTypeDefinition)
+/// @param costs Cost of moving onto each tile type, by default only kTileType_Empty tiles are walkable
+/// @param diagonals Allow the 4 diagonal moves
+/// @throw std::invalid_argument If a cost is negative
+/// @throw std::length_error If the grid has more than 2^32 - 1 cells
+inline Pathfinder::Pathfinder(const Grid& grid, const TileCosts& costs, const bool diagonals)
+    : m_rows(grid.NRows()), m_cols(grid.NCols()), m_diagonals(diagonals)
+{
+    if (m_rows * m_cols >= kNone)
+        throw std::length_error("Pathfinder::Pathfinder(): Grid is too big");
+    for (const auto& [tiletype, cost] : costs)
+    {
+        if (cost < 0.0) throw std::invalid_argument("Pathfinder::Pathfinder(): Costs cannot be negative");
+    }
+    auto walkable_cost = [](const double cost) { return std::isfinite(cost) ? cost : 0.0; };
+
+    // Cost of every character: undefined characters get the kTileType_Undefined cost
+    std::array<double, 256U> char_cost;
+    const auto undefined = costs.find(TileType::kTileType_Undefined);
+    char_cost.fill((undefined == costs.end()) ? 0.0 : walkable_cost(undefined->second));
+    for (const auto& [tiletype, character] : grid.GetTilesMap())
+    {
+        const auto cost = costs.find(tiletype);
+        char_cost[static_cast<unsigned char>(character)] = (cost == costs.end()) ? 0.0 : walkable_cost(cost->second);
+    }
+
+    m_cost.resize(m_rows * m_cols);
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        const char* src = grid.data() + row * grid.RowStride();
+        for (std::size_t col{0U}; col < m_cols; ++col)
+            m_cost[row * m_cols + col] = char_cost[static_cast<unsigned char>(src[col])];
+    }
+    for (const double cost : m_cost)
+    {
+        if (cost <= 0.0) continue;
+        if ((m_min_cost > 0.0) && (cost != m_min_cost)) m_uniform = false;
+        m_min_cost = (m_min_cost > 0.0) ? std::min(m_min_cost, cost) : cost;
+    }
+
+    const std::size_t n_cells{m_rows * m_cols};
+    m_seen.assign(n_cells, 0U);
+    m_closed.assign(n_cells, 0U);
+    m_target.assign(n_cells, 0U);
+    m_dist.resize(n_cells);
+    m_parent.resize(n_cells);
+}
+
+/// @brief Shortest path between two cells
+/// @return The path, std::nullopt if the target cannot be reached
+/// @throw std::out_of_range If a cell is outside of the grid
+inline std::optional<Path> Pathfinder::FindPath(const Position<std::size_t>& source,
+                                                const Position<std::size_t>& target, const PathAlgorithm algorithm)
+{
+    return FindPath(std::vector<Position<std::size_t>>{source}, std::vector<Position<std::size_t>>{target}, algorithm);
+}
+
+/// @brief Shortest path from any of the sources to the closest of the targets, in a single search
+/// @details The A* heuristic is the distance to the closest target, its cost grows with the number of targets
+/// @return The path, std::nullopt if no target can be reached
+/// @throw std::out_of_range If a cell is outside of the grid
+inline std::optional<Path> Pathfinder::FindPath(const std::vector<Position<std::size_t>>& sources,
+                                                const std::vector<Position<std::size_t>>& targets,
+                                                const PathAlgorithm algorithm)
+{
+    std::uint32_t found{m_Begin(sources, targets)};
+    if ((found == kNone) && !m_targets.empty())
+    {
+        switch (algorithm)
+        {
+            case PathAlgorithm::kBfs:
+                found = m_Bfs();
+                break;
+            case PathAlgorithm::kDijkstra:
+                found = m_BestFirst(false);
+                break;
+            case PathAlgorithm::kAStar:
+                found = m_BestFirst(true);
+                break;
+            case PathAlgorithm::kJumpPoint:
+                found = (m_diagonals && m_uniform) ? m_JumpPointSearch() : m_BestFirst(true);
+                break;
+        }
+    }
+    if (found == kNone) return std::nullopt;
+    return m_Reconstruct(found);
+}
+
+/// @brief Distance from the closest source to every cell
+/// @param algorithm kBfs counts the moves, any other algorithm runs Dijkstra on the costs
+/// @return Distances, infinity for the cells that cannot be reached
+/// @throw std::out_of_range If a source is outside of the grid
+inline Matrix<double> Pathfinder::Distances(const std::vector<Position<std::size_t>>& sources,
+                                            const PathAlgorithm algorithm)
+{
+    m_Begin(sources, {});
+    if (algorithm == PathAlgorithm::kBfs)
+        m_Bfs();
+    else
+        m_BestFirst(false);
+
+    Matrix<double> distances(m_rows, m_cols, std::numeric_limits<double>::infinity());
+    for (std::size_t cell{0U}; cell < m_rows * m_cols; ++cell)
+    {
+        if (m_seen[cell] == m_generation) distances(cell / m_cols, cell % m_cols) = m_dist[cell];
+    }
+    return distances;
+}
+
+/// @brief Start a query: invalidate the scratch state, mark the targets and seed the walkable sources
+/// @return A source which is also a target, kNone otherwise
+inline std::uint32_t Pathfinder::m_Begin(const std::vector<Position<std::size_t>>& sources,
+                                         const std::vector<Position<std::size_t>>& targets)
+{
+    auto check = [this](const Position<std::size_t>& cell) {
+        if ((cell.x >= m_cols) || (cell.y >= m_rows))
+            throw std::out_of_range("Pathfinder::FindPath(): Position is out of range");
+    };
+    for (const auto& cell : sources)
+        check(cell);
+    for (const auto& cell : targets)
+        check(cell);
+
+    if (++m_generation == 0U)
+    {
+        // Stamps wrapped around: clear them once every 2^32 queries
+        std::fill(m_seen.begin(), m_seen.end(), 0U);
+        std::fill(m_closed.begin(), m_closed.end(), 0U);
+        std::fill(m_target.begin(), m_target.end(), 0U);
+        m_generation = 1U;
+    }
+    m_expanded = 0U;
+    m_queue.clear();
+    m_heap.clear();
+    m_targets.clear();
+    for (const auto& cell : targets)
+    {
+        if (!m_Walkable(long(cell.y), long(cell.x))) continue;
+        m_target[m_Index(long(cell.y), long(cell.x))] = m_generation;
+        m_targets.emplace_back(long(cell.y), long(cell.x));
+    }
+
+    std::uint32_t found{kNone};
+    for (const auto& cell : sources)
+    {
+        if (!m_Walkable(long(cell.y), long(cell.x))) continue;
+        const std::uint32_t index{m_Index(long(cell.y), long(cell.x))};
+        if (m_seen[index] == m_generation) continue;
+        m_Seed(index, 0.0, kNone, 0.0);
+        m_queue.push_back(index);
+        if (m_IsTarget(index)) found = index;
+    }
+    return found;
+}
+
+/// @brief Record a (better) distance for a cell and push it on the open list
+inline void Pathfinder::m_Seed(const std::uint32_t cell, const double dist, const std::uint32_t parent,
+                               const double priority)
+{
+    m_seen[cell] = m_generation;
+    m_dist[cell] = dist;
+    m_parent[cell] = parent;
+    m_heap.emplace_back(priority, cell);
+    std::push_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+}
+
+/// @brief Distance (in moves) between two cells, octile with diagonal moves and manhattan otherwise
+inline double Pathfinder::m_Octile(const long d_row, const long d_col) const
+{
+    const long a{std::abs(d_row)};
+    const long b{std::abs(d_col)};
+    if (!m_diagonals) return double(a + b);
+    return double(std::max(a, b) - std::min(a, b)) + kSqrt2 * double(std::min(a, b));
+}
+
+/// @brief Admissible estimate of the cost from a cell to the closest target
+inline double Pathfinder::m_Heuristic(const std::uint32_t cell) const
+{
+    const long row{long(cell / m_cols)};
+    const long col{long(cell % m_cols)};
+    double best{std::numeric_limits<double>::infinity()};
+    for (const auto& [target_row, target_col] : m_targets)
+        best = std::min(best, m_Octile(target_row - row, target_col - col));
+    return best * m_min_cost;
+}
+
+/// @brief Call callback(neighbour, move_length) for every walkable neighbour of a cell
+template <typename F>
+void Pathfinder::m_ForEachNeighbour(const std::uint32_t cell, F&& callback) const
+{
+    static constexpr std::array<std::pair<long, long>, 8U> kMoves{
+        {{-1, 0}, {0, -1}, {0, 1}, {1, 0}, {-1, -1}, {-1, 1}, {1, -1}, {1, 1}}};
+    const long row{long(cell / m_cols)};
+    const long col{long(cell % m_cols)};
+    const std::size_t n_moves{m_diagonals ? 8U : 4U};
+    for (std::size_t k{0U}; k < n_moves; ++k)
+    {
+        const auto [d_row, d_col] = kMoves[k];
+        if (!m_Walkable(row + d_row, col + d_col)) continue;
+        if ((k >= 4U) && (!m_Walkable(row + d_row, col) || !m_Walkable(row, col + d_col))) continue;
+        callback(m_Index(row + d_row, col + d_col), (k >= 4U) ? kSqrt2 : 1.0);
+    }
+}
+
+/// @brief Breadth-first search from the seeded sources
+/// @return First target reached, kNone if none (or no target)
+inline std::uint32_t Pathfinder::m_Bfs()
+{
+    for (std::size_t head{0U}; head < m_queue.size(); ++head)
+    {
+        const std::uint32_t cell{m_queue[head]};
+        ++m_expanded;
+        std::uint32_t found{kNone};
+        m_ForEachNeighbour(cell, [this, cell, &found](const std::uint32_t next, double) {
+            if ((found != kNone) || (m_seen[next] == m_generation)) return;
+            m_seen[next] = m_generation;
+            m_dist[next] = m_dist[cell] + 1.0;
+            m_parent[next] = cell;
+            m_queue.push_back(next);
+            if (m_IsTarget(next)) found = next;
+        });
+        if (found != kNone) return found;
+    }
+    return kNone;
+}
+
+/// @brief Dijkstra (or A*) search from the seeded sources
+/// @return Closest target, kNone if none (or no target)
+inline std::uint32_t Pathfinder::m_BestFirst(const bool use_heuristic)
+{
+    if (use_heuristic)
+    {
+        for (auto& [priority, cell] : m_heap)
+            priority = m_Heuristic(cell);
+        std::make_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+    }
+    while (!m_heap.empty())
+    {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+        const std::uint32_t cell{m_heap.back().second};
+        m_heap.pop_back();
+        if (m_closed[cell] == m_generation) continue;
+        m_closed[cell] = m_generation;
+        ++m_expanded;
+        if (m_IsTarget(cell)) return cell;
+
+        m_ForEachNeighbour(cell, [this, cell, use_heuristic](const std::uint32_t next, const double length) {
+            if (m_closed[next] == m_generation) return;
+            const double dist{m_dist[cell] + length * m_cost[next]};
+            if ((m_seen[next] == m_generation) && (dist >= m_dist[next])) return;
+            m_Seed(next, dist, cell, dist + (use_heuristic ? m_Heuristic(next) : 0.0));
+        });
+    }
+    return kNone;
+}
+
+/// @brief Jump point search (uniform costs, diagonal moves without corner cutting) from the seeded sources
+/// @details Only the jump points (cells with a forced neighbour, or targets) enter the open list: straight and
+///          diagonal runs between them are scanned without touching the scratch state
+/// @return Closest target, kNone if none
+inline std::uint32_t Pathfinder::m_JumpPointSearch()
+{
+    for (auto& [priority, cell] : m_heap)
+        priority = m_Heuristic(cell);
+    std::make_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+
+    std::array<std::pair<long, long>, 8U> directions;
+    while (!m_heap.empty())
+    {
+        std::pop_heap(m_heap.begin(), m_heap.end(), std::greater<HeapEntry>());
+        const std::uint32_t cell{m_heap.back().second};
+        m_heap.pop_back();
+        if (m_closed[cell] == m_generation) continue;
+        m_closed[cell] = m_generation;
+        ++m_expanded;
+        if (m_IsTarget(cell)) return cell;
+
+        // Pruned neighbours, given the direction the cell has been reached from
+        const long row{long(cell / m_cols)};
+        const long col{long(cell % m_cols)};
+        std::size_t n_directions{0U};
+        auto add = [&](const long d_row, const long d_col) {
+            if (m_Walkable(row + d_row, col + d_col)) directions[n_directions++] = {d_row, d_col};
+        };
+        if (m_parent[cell] == kNone)
+        {
+            m_ForEachNeighbour(cell, [&](const std::uint32_t next, double) {
+                directions[n_directions++] = {long(next / m_cols) - row, long(next % m_cols) - col};
+            });
+        }
+        else
+        {
+            const long d_row{(row > long(m_parent[cell] / m_cols)) - (row < long(m_parent[cell] / m_cols))};
+            const long d_col{(col > long(m_parent[cell] % m_cols)) - (col < long(m_parent[cell] % m_cols))};
+            if ((d_row != 0) && (d_col != 0))
+            {
+                const bool vertical{m_Walkable(row + d_row, col)};
+                const bool horizontal{m_Walkable(row, col + d_col)};
+                if (vertical) add(d_row, 0);
+                if (horizontal) add(0, d_col);
+                if (vertical && horizontal) add(d_row, d_col);
+            }
+            else if (d_col != 0)
+            {
+                const bool up{m_Walkable(row - 1, col)};
+                const bool down{m_Walkable(row + 1, col)};
+                if (m_Walkable(row, col + d_col))
+                {
+                    add(0, d_col);
+                    if (up) add(-1, d_col);
+                    if (down) add(1, d_col);
+                }
+                if (up) add(-1, 0);
+                if (down) add(1, 0);
+            }
+            else
+            {
+                const bool left{m_Walkable(row, col - 1)};
+                const bool right{m_Walkable(row, col + 1)};
+                if (m_Walkable(row + d_row, col))
+                {
+                    add(d_row, 0);
+                    if (left) add(d_row, -1);
+                    if (right) add(d_row, 1);
+                }
+                if (left) add(0, -1);
+                if (right) add(0, 1);
+            }
+        }
+
+        for (std::size_t k{0U}; k < n_directions; ++k)
+        {
+            const auto [d_row, d_col] = directions[k];
+            const std::uint32_t jump_point{m_Jump(row + d_row, col + d_col, d_row, d_col)};
+            if ((jump_point == kNone) || (m_closed[jump_point] == m_generation)) continue;
+            const long jump_row{long(jump_point / m_cols)};
+            const long jump_col{long(jump_point % m_cols)};
+            const double dist{m_dist[cell] + m_min_cost * m_Octile(jump_row - row, jump_col - col)};
+            if ((m_seen[jump_point] == m_generation) && (dist >= m_dist[jump_point])) continue;
+            m_Seed(jump_point, dist, cell, dist + m_Heuristic(jump_point));
+        }
+    }
+    return kNone;
+}
+
+/// @brief Scan from a cell in a straight direction
+/// @return First jump point met, kNone if the run ends on a non-walkable cell
+inline std::uint32_t Pathfinder::m_JumpStraight(long row, long col, const long d_row, const long d_col) const
+{
+    while (m_Walkable(row, col))
+    {
+        const std::uint32_t cell{m_Index(row, col)};
+        if (m_IsTarget(cell)) return cell;
+        if (d_col != 0)
+        {
+            if ((m_Walkable(row - 1, col) && !m_Walkable(row - 1, col - d_col)) ||
+                (m_Walkable(row + 1, col) && !m_Walkable(row + 1, col - d_col)))
+                return cell;
+        }
+        else
+        {
+            if ((m_Walkable(row, col - 1) && !m_Walkable(row - d_row, col - 1)) ||
+                (m_Walkable(row, col + 1) && !m_Walkable(row - d_row, col + 1)))
+                return cell;
+        }
+        row += d_row;
+        col += d_col;
+    }
+    return kNone;
+}
+
+/// @brief Scan from a cell in a (straight or diagonal) direction
+/// @return First jump point met, kNone if none
+inline std::uint32_t Pathfinder::m_Jump(long row, long col, const long d_row, const long d_col) const
+{
+    if ((d_row == 0) || (d_col == 0)) return m_JumpStraight(row, col, d_row, d_col);
+    while (m_Walkable(row, col))
+    {
+        const std::uint32_t cell{m_Index(row, col)};
+        if (m_IsTarget(cell)) return cell;
+        // A diagonal cell is a jump point if one of its straight runs reaches a jump point
+        if ((m_JumpStraight(row, col + d_col, 0, d_col) != kNone) ||
+            (m_JumpStraight(row + d_row, col, d_row, 0) != kNone))
+            return cell;
+        if (!m_Walkable(row, col + d_col) || !m_Walkable(row + d_row, col)) return kNone;
+        row += d_row;
+        col += d_col;
+    }
+    return kNone;
+}
+
+/// @brief Walk the parents back from a target, filling the straight/diagonal runs between jump points
+inline Path Pathfinder::m_Reconstruct(const std::uint32_t target) const
+{
+    Path path;
+    path.cost = m_dist[target];
+    for (std::uint32_t cell{target}; cell != kNone; cell = m_parent[cell])
+    {
+        long row{long(cell / m_cols)};
+        long col{long(cell % m_cols)};
+        path.cells.emplace_back(std::size_t(col), std::size_t(row));
+        if (m_parent[cell] == kNone) break;
+        const long parent_row{long(m_parent[cell] / m_cols)};
+        const long parent_col{long(m_parent[cell] % m_cols)};
+        const long d_row{(parent_row > row) - (parent_row < row)};
+        const long d_col{(parent_col > col) - (parent_col < col)};
+        for (row += d_row, col += d_col; (row != parent_row) || (col != parent_col); row += d_row, col += d_col)
+            path.cells.emplace_back(std::size_t(col), std::size_t(row));
+    }
+    std::reverse(path.cells.begin(), path.cells.end());
+    return path;
+}
+
+}  // namespace commonlib
+
+#endif  // ALGORITHMS_PATHFINDING_H
@@ -0,0 +1,142 @@
+/// @file simulation.h
+/// @author Alberto Santagostino
+
+#ifndef ALGORITHMS_SIMULATION_H
+#define ALGORITHMS_SIMULATION_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifdef TEST_BUILD
+#include <data_structures/grid.h>
+#else
+#include <commonlib/include/data_structures/grid.h>
+#endif
+
+namespace commonlib
+{
+/// @brief Cycle of the states of a simulation: the state after step s >= start is the state after step s + period
+struct Cycle
+{
+    std::size_t start{0U};
+    std::size_t period{0U};
+};
+
+/// @class Simulation
+/// @brief Drives a deterministic simulation on a Grid, recording the hash of the state after every step to detect
+///        when a state repeats. Once the cycle is known any later step is reached with less than one period of steps
+/// @details The grid hash (Grid::Hash) is enabled at construction. By default all the cells are rehashed after every
+///          step, whatever the step writes through; if every write of the step goes through Grid::operator() or a
+///          bulk edit (e.g. a Stencil, tracked or not), pass logged_writes = true to update the hash in O(writes)
+///          instead. A step writing through operator[], data() or views must not set it: its states would not be
+///          seen. States are compared by their 64-bit hash only. Actors are not part of the state
+/// @tparam Step Callable as step(Grid&), advancing the grid by one step
+template <typename Step>
+class Simulation
+{
+  public:
+    // Constructors
+    Simulation(Grid& grid, Step step, const bool logged_writes = false);
+
+    // Simulation
+    std::optional<Cycle> FindCycle(const std::size_t max_steps);
+    void AdvanceTo(const std::size_t target_step);
+
+    // Getters
+    inline std::size_t CurrentStep() const { return m_current; }
+    inline const std::optional<Cycle>& GetCycle() const { return m_cycle; }
+    inline const std::vector<std::uint64_t>& History() const { return m_history; }  ///< Hash after step i
+    std::size_t EquivalentStep(const std::size_t step) const;
+
+  private:
+    Grid& m_grid;
+    Step m_step;
+    bool m_logged_writes;                                     ///< Steps write only through operator() or bulk edits
+    std::size_t m_current{0U};                                ///< Step the grid is at
+    std::vector<std::uint64_t> m_history;                     ///< Hash after every step, until the cycle is found
+    std::unordered_map<std::uint64_t, std::size_t> m_seen;    ///< Hash -> first step with that hash
+    std::optional<Cycle> m_cycle;
+
+    void m_Step();
+};
+
+/// @brief Constructor: the current state of the grid is step 0
+/// @param grid Grid advanced in place by every step
+/// @param step Step function, called as step(grid)
+/// @param logged_writes The step writes only through Grid::operator() or bulk edits: the hash is updated
+///        incrementally instead of being recomputed after every step
+template <typename Step>
+Simulation<Step>::Simulation(Grid& grid, Step step, const bool logged_writes)
+    : m_grid(grid), m_step(std::move(step)), m_logged_writes(logged_writes)
+{
+    if (!m_grid.IsHashing()) m_grid.EnableHashing(true);
+    m_grid.RehashCells();
+    m_history.push_back(m_grid.Hash());
+    m_seen.emplace(m_history.back(), 0U);
+}
+
+/// @brief Run steps until a state repeats (or max_steps steps have been run)
+/// @return The cycle, std::nullopt if no state repeated
+template <typename Step>
+std::optional<Cycle> Simulation<Step>::FindCycle(const std::size_t max_steps)
+{
+    for (std::size_t step{0U}; (step < max_steps) && !m_cycle; ++step)
+        m_Step();
+    return m_cycle;
+}
+
+/// @brief Bring the grid to the state after target_step steps
+/// @details Before the cycle is known the steps are run (and recorded) one by one; once it is known, only the steps
+///          needed to reach the same phase of the cycle are run, so the target can even precede the current step
+/// @throw std::logic_error If the target step cannot be reached (it precedes the current step and is not in the cycle)
+template <typename Step>
+void Simulation<Step>::AdvanceTo(const std::size_t target_step)
+{
+    while (!m_cycle && (m_current < target_step))
+        m_Step();
+    if (m_current == target_step) return;
+    if (!m_cycle || (target_step < m_cycle->start))
+        throw std::logic_error("Simulation::AdvanceTo(target_step): The target step precedes the current step");
+
+    const std::size_t period{m_cycle->period};
+    const std::size_t phase{(m_current - m_cycle->start) % period};
+    const std::size_t target_phase{(target_step - m_cycle->start) % period};
+    const std::size_t n_steps{(target_phase + period - phase) % period};
+    for (std::size_t step{0U}; step < n_steps; ++step)
+        m_step(m_grid);
+    m_current = target_step;
+}
+
+/// @brief Smallest step whose state is the state after the given step (the step itself if no cycle is known)
+template <typename Step>
+std::size_t Simulation<Step>::EquivalentStep(const std::size_t step) const
+{
+    if (!m_cycle || (step < m_cycle->start)) return step;
+    return m_cycle->start + (step - m_cycle->start) % m_cycle->period;
+}
+
+/// @brief Run one step and record its state
+template <typename Step>
+void Simulation<Step>::m_Step()
+{
+    m_step(m_grid);
+    ++m_current;
+    if (!m_logged_writes) m_grid.RehashCells();
+    const std::uint64_t hash{m_grid.Hash()};
+    const auto [it, inserted] = m_seen.emplace(hash, m_current);
+    if (!inserted)
+    {
+        m_cycle = Cycle{it->second, m_current - it->second};
+        return;
+    }
+    m_history.push_back(hash);
+}
+
+}  // namespace commonlib
+
+#endif  // ALGORITHMS_SIMULATION_H
@@ -0,0 +1,299 @@
+/// @file stencil.h
+/// @author Alberto Santagostino
+
+#ifndef ALGORITHMS_STENCIL_H
+#define ALGORITHMS_STENCIL_H
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef TEST_BUILD
+#include <data_structures/grid.h>
+#include <data_structures/matrix.h>
+#include <utils/thread_pool.h>
+#else
+#include <commonlib/include/data_structures/grid.h>
+#include <commonlib/include/data_structures/matrix.h>
+#include <commonlib/include/utils/thread_pool.h>
+#endif
+
+namespace commonlib
+{
+/// @brief Cells read by a stencil rule around the updated cell
+enum class Neighbourhood
+{
+    kVonNeumann,  ///< 4 neighbours, in order N, W, E, S
+    kMoore,       ///< 8 neighbours, in order NW, N, NE, W, E, SW, S, SE
+    kWindow       ///< Full window_width x window_width window (center included), row-major, like CutWindow
+};
+
+/// @brief Options of a Stencil
+template <typename T>
+struct StencilOptions
+{
+    Neighbourhood neighbourhood{Neighbourhood::kMoore};
+    std::size_t window_width{3U};  ///< Only for kWindow, must be odd
+    T fill_value{};                ///< Value read outside of the matrix (when not wrapping)
+    bool wrap{false};              ///< Wrap indices around the borders (always on for infinite Grids)
+};
+
+/// @class Stencil
+/// @brief Double-buffered cellular-automaton engine: every step computes rule(center, neighbours) for all cells of
+///        the matrix into a back buffer, then swaps it with the matrix storage
+/// @details Rows are split in bands processed by the optional thread pool. Interior cells read their neighbours
+///          through precomputed offsets, only the border cells pay for the wrap/fill logic. On a Grid with change
+///          tracking enabled (Grid::TrackChanges) only the cells around the last changes are recomputed
+/// @tparam M Matrix<T, BoundsCheck> or a class derived from it (e.g. Grid)
+/// @tparam Rule Callable as T(const T& center, RowView<const T> neighbours)
+template <typename M, typename Rule>
+class Stencil
+{
+  public:
+    using T = typename M::value_type;
+
+    // Constructors
+    Stencil(M& matrix, Rule rule, const StencilOptions<T> options = {}, ThreadPool* pool = nullptr);
+
+    // Simulation
+    std::size_t Step();
+    std::size_t Run(const std::size_t n_steps, const bool stop_at_fixed_point = false);
+
+    // Getters
+    inline std::size_t NeighbourCount() const { return m_offsets.size(); }
+    inline std::size_t Steps() const { return m_steps; }
+    inline double StepsPerSecond() const { return (m_elapsed > 0.0) ? (double(m_steps) / m_elapsed) : 0.0; }
+
+  private:
+    M& m_matrix;
+    typename M::matrix_type m_back;  ///< Same element type and bounds-check policy as the Matrix base of M
+    Rule m_rule;
+    StencilOptions<T> m_options;
+    ThreadPool* m_pool;
+    std::vector<std::pair<long, long>> m_offsets;  ///< (d_row, d_col) of every value passed to the rule
+    std::size_t m_halo;                            ///< Distance of the farthest neighbour
+    std::size_t m_steps{0U};
+    double m_elapsed{0.0};  ///< Seconds spent in Step()
+
+    template <typename Work>
+    std::size_t m_ForBands(const std::size_t n_items, Work work);
+    std::vector<std::ptrdiff_t> m_LinearOffsets() const;
+    T m_Apply(const std::size_t row, const std::size_t col, const std::vector<std::ptrdiff_t>& linear_offsets,
+              T* neighbours);
+    std::size_t m_StepRows(const std::size_t first_row, const std::size_t last_row);
+    std::size_t m_StepTracked();
+};
+
+/// @brief Constructor
+/// @param matrix Matrix updated in place by every step (its storage is swapped with the back buffer)
+/// @param rule Update rule, called as rule(center, neighbours)
+/// @param options Neighbourhood, out-of-bounds policy
+/// @param pool Thread pool to split the rows on (nullptr to run on the calling thread)
+/// @throw std::out_of_range If window_width is even
+template <typename M, typename Rule>
+Stencil<M, Rule>::Stencil(M& matrix, Rule rule, const StencilOptions<T> options, ThreadPool* pool)
+    : m_matrix(matrix), m_back(matrix), m_rule(std::move(rule)), m_options(options), m_pool(pool)
+{
+    if constexpr (std::is_base_of_v<Grid, M>)
+    {
+        if (matrix.IsInfinite()) m_options.wrap = true;
+    }
+    switch (m_options.neighbourhood)
+    {
+        case Neighbourhood::kVonNeumann:
+            m_offsets = {{-1, 0}, {0, -1}, {0, 1}, {1, 0}};
+            m_halo = 1U;
+            break;
+        case Neighbourhood::kMoore:
+            m_offsets = {{-1, -1}, {-1, 0}, {-1, 1}, {0, -1}, {0, 1}, {1, -1}, {1, 0}, {1, 1}};
+            m_halo = 1U;
+            break;
+        case Neighbourhood::kWindow:
+        {
+            if ((m_options.window_width == 0U) || (m_options.window_width % 2U == 0U))
+                throw std::out_of_range("Stencil::Stencil(): window_width must be an odd number");
+            const long half{long(m_options.window_width - 1U) / 2};
+            for (long dr{-half}; dr <= half; ++dr)
+                for (long dc{-half}; dc <= half; ++dc)
+                    m_offsets.emplace_back(dr, dc);
+            m_halo = std::size_t(half);
+            break;
+        }
+    }
+}
+
+/// @brief Run one step on all cells
+/// @details On a Grid tracking its changes only the active cells (around the ones changed by the previous step or
+///          written through operator() since then) are recomputed, the new values are written through
+///          Grid::operator() and the step is committed, so Grid::IsFixedPoint() tells when the simulation is over
+/// @return Number of cells whose value changed (on a tracked Grid, including the writes done since the last step)
+template <typename M, typename Rule>
+std::size_t Stencil<M, Rule>::Step()
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::size_t changed{0U};
+    bool tracked{false};
+    if constexpr (std::is_base_of_v<Grid, M>)
+    {
+        if (m_matrix.IsTrackingChanges())
+        {
+            changed = m_StepTracked();
+            tracked = true;
+        }
+    }
+    if (!tracked)
+    {
+        changed = m_ForBands(m_matrix.NRows(), [this](const std::size_t first_row, const std::size_t last_row) {
+            return m_StepRows(first_row, last_row);
+        });
+        m_matrix.SwapData(m_back);
+    }
+    ++m_steps;
+    m_elapsed += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    return changed;
+}
+
+/// @brief Run several steps
+/// @param stop_at_fixed_point Stop as soon as a step changes no cell
+/// @return Number of executed steps
+template <typename M, typename Rule>
+std::size_t Stencil<M, Rule>::Run(const std::size_t n_steps, const bool stop_at_fixed_point)
+{
+    for (std::size_t step{0U}; step < n_steps; ++step)
+    {
+        if ((Step() == 0U) && stop_at_fixed_point) return step + 1U;
+    }
+    return n_steps;
+}
+
+/// @brief Split [0, n_items) in bands, run work(first, last) on each of them (on the pool if any)
+/// @return Sum of the values returned by work
+template <typename M, typename Rule>
+template <typename Work>
+std::size_t Stencil<M, Rule>::m_ForBands(const std::size_t n_items, Work work)
+{
+    if ((m_pool == nullptr) || (m_pool->Size() < 2U) || (n_items < 2U))
+    {
+        return work(std::size_t{0U}, n_items);
+    }
+    const std::size_t n_bands{std::min(n_items, m_pool->Size() * 2U)};
+    std::vector<std::size_t> results(n_bands, 0U);
+    m_pool->ParallelFor(n_bands, [&work, &results, n_items, n_bands](std::size_t band) {
+        results[band] = work(band * n_items / n_bands, (band + 1U) * n_items / n_bands);
+    });
+    std::size_t total{0U};
+    for (const auto result : results)
+        total += result;
+    return total;
+}
+
+/// @brief Offsets of the neighbours in the current matrix storage
+template <typename M, typename Rule>
+std::vector<std::ptrdiff_t> Stencil<M, Rule>::m_LinearOffsets() const
+{
+    std::vector<std::ptrdiff_t> linear_offsets;
+    for (const auto& [dr, dc] : m_offsets)
+        linear_offsets.push_back(std::ptrdiff_t(dr) * std::ptrdiff_t(m_matrix.RowStride()) + dc);
+    return linear_offsets;
+}
+
+/// @brief Gather the neighbours of a cell and apply the rule
+/// @param linear_offsets Result of m_LinearOffsets()
+/// @param neighbours Scratch buffer of NeighbourCount() elements
+template <typename M, typename Rule>
+typename Stencil<M, Rule>::T Stencil<M, Rule>::m_Apply(const std::size_t row, const std::size_t col,
+                                                       const std::vector<std::ptrdiff_t>& linear_offsets,
+                                                       T* neighbours)
+{
+    const std::size_t n_rows{m_matrix.NRows()};
+    const std::size_t n_cols{m_matrix.NCols()};
+    const T* front = m_matrix.data();
+    const std::size_t front_stride{m_matrix.RowStride()};
+    const T* center = front + row * front_stride + col;
+    if ((row >= m_halo) && (row + m_halo < n_rows) && (col >= m_halo) && (col + m_halo < n_cols))
+    {
+        for (std::size_t k{0U}; k < linear_offsets.size(); ++k)
+            neighbours[k] = center[linear_offsets[k]];
+    }
+    else
+    {
+        for (std::size_t k{0U}; k < m_offsets.size(); ++k)
+        {
+            long r{long(row) + m_offsets[k].first};
+            long c{long(col) + m_offsets[k].second};
+            const bool inside{(r >= 0) && (c >= 0) && (r < long(n_rows)) && (c < long(n_cols))};
+            if (!inside && !m_options.wrap)
+            {
+                neighbours[k] = m_options.fill_value;
+                continue;
+            }
+            r = ((r % long(n_rows)) + long(n_rows)) % long(n_rows);
+            c = ((c % long(n_cols)) + long(n_cols)) % long(n_cols);
+            neighbours[k] = front[std::size_t(r) * front_stride + std::size_t(c)];
+        }
+    }
+    return m_rule(*center, RowView<const T>(neighbours, m_offsets.size()));
+}
+
+/// @brief Compute rows [first_row, last_row) of the back buffer from the matrix
+/// @return Number of changed cells in the rows
+template <typename M, typename Rule>
+std::size_t Stencil<M, Rule>::m_StepRows(const std::size_t first_row, const std::size_t last_row)
+{
+    const std::size_t n_cols{m_matrix.NCols()};
+    const T* front = m_matrix.data();
+    const std::size_t front_stride{m_matrix.RowStride()};
+    T* back = m_back.data();
+    const std::size_t back_stride{m_back.RowStride()};
+    const std::vector<std::ptrdiff_t> linear_offsets = m_LinearOffsets();
+    std::unique_ptr<T[]> neighbours = std::make_unique<T[]>(m_offsets.size());
+
+    std::size_t changed{0U};
+    for (std::size_t row{first_row}; row < last_row; ++row)
+    {
+        for (std::size_t col{0U}; col < n_cols; ++col)
+        {
+            T& out = back[row * back_stride + col];
+            out = m_Apply(row, col, linear_offsets, neighbours.get());
+            if (!(out == front[row * front_stride + col])) ++changed;
+        }
+    }
+    return changed;
+}
+
+/// @brief Step of a Grid tracking its changes: compute the active cells into the back buffer (used as scratch), then
+///        write the changed ones through Grid::operator() and commit
+template <typename M, typename Rule>
+std::size_t Stencil<M, Rule>::m_StepTracked()
+{
+    const std::vector<std::pair<std::size_t, std::size_t>> cells = m_matrix.ActiveCells(m_halo, m_options.wrap);
+    const std::vector<std::ptrdiff_t> linear_offsets = m_LinearOffsets();
+    T* back = m_back.data();
+    const std::size_t back_stride{m_back.RowStride()};
+
+    m_ForBands(cells.size(), [&](const std::size_t first, const std::size_t last) {
+        std::unique_ptr<T[]> neighbours = std::make_unique<T[]>(m_offsets.size());
+        for (std::size_t i{first}; i < last; ++i)
+        {
+            const auto [row, col] = cells[i];
+            back[row * back_stride + col] = m_Apply(row, col, linear_offsets, neighbours.get());
+        }
+        return std::size_t{0U};
+    });
+    const M& front = m_matrix;
+    for (const auto& [row, col] : cells)
+    {
+        const T& value = back[row * back_stride + col];
+        if (!(value == front(row, col))) m_matrix(row, col) = value;
+    }
+    return m_matrix.CommitChanges();
+}
+
+}  // namespace commonlib
+
+#endif  // ALGORITHMS_STENCIL_H
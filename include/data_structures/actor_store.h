@@ -0,0 +1,334 @@
+/// @file actor_store.h
+/// @author Alberto Santagostino
+
+#ifndef DATA_STRUCTURES_ACTOR_STORE_H
+#define DATA_STRUCTURES_ACTOR_STORE_H
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#ifdef TEST_BUILD
+#include <data_structures/grid.h>
+#include <primitives/position.h>
+#else
+#include <commonlib/include/data_structures/grid.h>
+#include <commonlib/include/primitives/position.h>
+#endif
+
+namespace commonlib
+{
+/// @class ActorStore
+/// @brief Structure-of-arrays container of actors: ids, characters, positions and velocities are stored in separate
+///        contiguous columns, so that per-tick passes stream through memory and vectorize
+/// @details Actors are kept densely packed (removal moves the last actor in the freed slot): dense indices are not
+///          stable, ids are. Ids are resolved through a paged sparse array (id -> dense index) allocated lazily, 4096
+///          ids per page (the page table grows with the largest id, ids are meant to be reasonably dense). Positions
+///          are x = column, y = row, as for Actor
+/// @tparam T Coordinate type (signed, velocities can be negative)
+template <typename T = long>
+class ActorStore
+{
+    static_assert(std::is_signed_v<T>, "ActorStore coordinates must be signed");
+
+  public:
+    // Setters
+    bool Add(const std::size_t id, const char character, const Position<T>& position,
+             const Position<T>& velocity = Position<T>());
+    bool Remove(const std::size_t id);
+    void Reserve(const std::size_t n_actors);
+    void Clear();
+    void SetPosition(const std::size_t id, const Position<T>& position);
+    void SetVelocity(const std::size_t id, const Position<T>& velocity);
+
+    // Getters
+    inline std::size_t Size() const { return m_ids.size(); }
+    inline bool Contains(const std::size_t id) const { return IndexOf(id).has_value(); }
+    std::optional<std::size_t> IndexOf(const std::size_t id) const;
+    Position<T> GetPosition(const std::size_t id) const;
+    Position<T> GetVelocity(const std::size_t id) const;
+    inline const std::vector<std::size_t>& Ids() const { return m_ids; }
+    inline const std::vector<char>& Characters() const { return m_characters; }
+    inline const std::vector<T>& X() const { return m_x; }
+    inline const std::vector<T>& Y() const { return m_y; }
+    inline const std::vector<T>& VelocityX() const { return m_vx; }
+    inline const std::vector<T>& VelocityY() const { return m_vy; }
+
+    // Batched passes
+    void Move(const Position<T>& delta);
+    void ApplyVelocity();
+    std::size_t ApplyVelocity(const Grid& grid, const TileType blocking = TileType::kTileType_Wall);
+    std::vector<std::size_t> CollideWithGrid(const Grid& grid,
+                                             const TileType blocking = TileType::kTileType_Wall) const;
+
+  private:
+    static constexpr std::uint32_t kNoIndex{std::numeric_limits<std::uint32_t>::max()};
+    static constexpr std::size_t kPageBits{12U};
+    static constexpr std::size_t kPageSize{std::size_t{1} << kPageBits};
+
+    // Dense columns
+    std::vector<std::size_t> m_ids;
+    std::vector<char> m_characters;
+    std::vector<T> m_x;
+    std::vector<T> m_y;
+    std::vector<T> m_vx;
+    std::vector<T> m_vy;
+    // Sparse index: id -> dense index
+    std::vector<std::unique_ptr<std::uint32_t[]>> m_pages;
+
+    std::uint32_t& m_Slot(const std::size_t id);
+    std::size_t m_Index(const std::size_t id, const char* caller) const;
+    bool m_Blocked(const Grid& grid, const char blocking_char, const bool has_blocking, T x, T y) const;
+};
+
+/// @brief Add an actor
+/// @return false if an actor with the same id already exists
+/// @throw std::length_error If the store already holds 2^32 - 1 actors
+template <typename T>
+bool ActorStore<T>::Add(const std::size_t id, const char character, const Position<T>& position,
+                        const Position<T>& velocity)
+{
+    if (Contains(id)) return false;
+    if (m_ids.size() >= kNoIndex) throw std::length_error("ActorStore<T>::Add(): Too many actors");
+    m_Slot(id) = static_cast<std::uint32_t>(m_ids.size());
+    m_ids.push_back(id);
+    m_characters.push_back(character);
+    m_x.push_back(position.x);
+    m_y.push_back(position.y);
+    m_vx.push_back(velocity.x);
+    m_vy.push_back(velocity.y);
+    return true;
+}
+
+/// @brief Remove an actor, the last actor takes its dense index
+/// @return false if the actor does not exist
+template <typename T>
+bool ActorStore<T>::Remove(const std::size_t id)
+{
+    const auto index = IndexOf(id);
+    if (!index) return false;
+    const std::size_t last{m_ids.size() - 1U};
+    if (*index != last)
+    {
+        m_ids[*index] = m_ids[last];
+        m_characters[*index] = m_characters[last];
+        m_x[*index] = m_x[last];
+        m_y[*index] = m_y[last];
+        m_vx[*index] = m_vx[last];
+        m_vy[*index] = m_vy[last];
+        m_Slot(m_ids[*index]) = static_cast<std::uint32_t>(*index);
+    }
+    m_Slot(id) = kNoIndex;
+    m_ids.pop_back();
+    m_characters.pop_back();
+    m_x.pop_back();
+    m_y.pop_back();
+    m_vx.pop_back();
+    m_vy.pop_back();
+    return true;
+}
+
+/// @brief Reserve the dense columns for a number of actors
+template <typename T>
+void ActorStore<T>::Reserve(const std::size_t n_actors)
+{
+    m_ids.reserve(n_actors);
+    m_characters.reserve(n_actors);
+    m_x.reserve(n_actors);
+    m_y.reserve(n_actors);
+    m_vx.reserve(n_actors);
+    m_vy.reserve(n_actors);
+}
+
+/// @brief Remove all actors
+template <typename T>
+void ActorStore<T>::Clear()
+{
+    m_ids.clear();
+    m_characters.clear();
+    m_x.clear();
+    m_y.clear();
+    m_vx.clear();
+    m_vy.clear();
+    m_pages.clear();
+}
+
+/// @brief Set the position of an actor
+/// @throw std::out_of_range If the actor does not exist
+template <typename T>
+void ActorStore<T>::SetPosition(const std::size_t id, const Position<T>& position)
+{
+    const std::size_t index{m_Index(id, "ActorStore<T>::SetPosition()")};
+    m_x[index] = position.x;
+    m_y[index] = position.y;
+}
+
+/// @brief Set the velocity of an actor
+/// @throw std::out_of_range If the actor does not exist
+template <typename T>
+void ActorStore<T>::SetVelocity(const std::size_t id, const Position<T>& velocity)
+{
+    const std::size_t index{m_Index(id, "ActorStore<T>::SetVelocity()")};
+    m_vx[index] = velocity.x;
+    m_vy[index] = velocity.y;
+}
+
+/// @brief Dense index of an actor (valid until the next removal)
+/// @return The index, std::nullopt if the actor does not exist
+template <typename T>
+std::optional<std::size_t> ActorStore<T>::IndexOf(const std::size_t id) const
+{
+    const std::size_t page{id >> kPageBits};
+    if ((page >= m_pages.size()) || !m_pages[page]) return std::nullopt;
+    const std::uint32_t index{m_pages[page][id & (kPageSize - 1U)]};
+    if (index == kNoIndex) return std::nullopt;
+    return std::size_t(index);
+}
+
+/// @brief Position of an actor
+/// @throw std::out_of_range If the actor does not exist
+template <typename T>
+Position<T> ActorStore<T>::GetPosition(const std::size_t id) const
+{
+    const std::size_t index{m_Index(id, "ActorStore<T>::GetPosition()")};
+    return Position<T>(m_x[index], m_y[index]);
+}
+
+/// @brief Velocity of an actor
+/// @throw std::out_of_range If the actor does not exist
+template <typename T>
+Position<T> ActorStore<T>::GetVelocity(const std::size_t id) const
+{
+    const std::size_t index{m_Index(id, "ActorStore<T>::GetVelocity()")};
+    return Position<T>(m_vx[index], m_vy[index]);
+}
+
+/// @brief Translate all actors by the same delta (Position::operator+= applied column-wise)
+template <typename T>
+void ActorStore<T>::Move(const Position<T>& delta)
+{
+    T* x = m_x.data();
+    T* y = m_y.data();
+    const std::size_t n{m_x.size()};
+    for (std::size_t i{0U}; i < n; ++i)
+        x[i] += delta.x;
+    for (std::size_t i{0U}; i < n; ++i)
+        y[i] += delta.y;
+}
+
+/// @brief Move every actor by its velocity (Position::operator+= applied column-wise)
+template <typename T>
+void ActorStore<T>::ApplyVelocity()
+{
+    T* __restrict x = m_x.data();
+    T* __restrict y = m_y.data();
+    const T* __restrict vx = m_vx.data();
+    const T* __restrict vy = m_vy.data();
+    const std::size_t n{m_x.size()};
+    for (std::size_t i{0U}; i < n; ++i)
+        x[i] += vx[i];
+    for (std::size_t i{0U}; i < n; ++i)
+        y[i] += vy[i];
+}
+
+/// @brief Move every actor by its velocity, unless the destination is blocked: outside of a finite grid, or a tile of
+///        the blocking type. Blocked actors stay in place and their velocity is zeroed. Destinations are wrapped on
+///        infinite grids
+/// @return Number of blocked actors
+template <typename T>
+std::size_t ActorStore<T>::ApplyVelocity(const Grid& grid, const TileType blocking)
+{
+    const auto tile = grid.GetTilesMap().find(blocking);
+    const bool has_blocking{tile != grid.GetTilesMap().end()};
+    const char blocking_char{has_blocking ? tile->second : '\0'};
+    const T n_rows{static_cast<T>(grid.NRows())};
+    const T n_cols{static_cast<T>(grid.NCols())};
+    std::size_t blocked{0U};
+    for (std::size_t i{0U}; i < m_x.size(); ++i)
+    {
+        T x{static_cast<T>(m_x[i] + m_vx[i])};
+        T y{static_cast<T>(m_y[i] + m_vy[i])};
+        if (m_Blocked(grid, blocking_char, has_blocking, x, y))
+        {
+            m_vx[i] = T{0};
+            m_vy[i] = T{0};
+            ++blocked;
+            continue;
+        }
+        if (grid.IsInfinite())
+        {
+            x = ((x % n_cols) + n_cols) % n_cols;
+            y = ((y % n_rows) + n_rows) % n_rows;
+        }
+        m_x[i] = x;
+        m_y[i] = y;
+    }
+    return blocked;
+}
+
+/// @brief Dense indices of the actors standing on a blocked cell (outside of a finite grid, or a blocking tile)
+template <typename T>
+std::vector<std::size_t> ActorStore<T>::CollideWithGrid(const Grid& grid, const TileType blocking) const
+{
+    const auto tile = grid.GetTilesMap().find(blocking);
+    const bool has_blocking{tile != grid.GetTilesMap().end()};
+    const char blocking_char{has_blocking ? tile->second : '\0'};
+    std::vector<std::size_t> collided;
+    for (std::size_t i{0U}; i < m_x.size(); ++i)
+    {
+        if (m_Blocked(grid, blocking_char, has_blocking, m_x[i], m_y[i])) collided.push_back(i);
+    }
+    return collided;
+}
+
+/// @brief Slot of the sparse index of an id, allocating its page if needed
+template <typename T>
+std::uint32_t& ActorStore<T>::m_Slot(const std::size_t id)
+{
+    const std::size_t page{id >> kPageBits};
+    if (page >= m_pages.size()) m_pages.resize(page + 1U);
+    if (!m_pages[page])
+    {
+        m_pages[page] = std::make_unique<std::uint32_t[]>(kPageSize);
+        std::fill(m_pages[page].get(), m_pages[page].get() + kPageSize, kNoIndex);
+    }
+    return m_pages[page][id & (kPageSize - 1U)];
+}
+
+/// @brief Dense index of an existing actor
+/// @throw std::out_of_range If the actor does not exist
+template <typename T>
+std::size_t ActorStore<T>::m_Index(const std::size_t id, const char* caller) const
+{
+    const auto index = IndexOf(id);
+    if (!index) throw std::out_of_range(std::string(caller) + ": Actor does not exist");
+    return *index;
+}
+
+/// @brief Check if a cell is outside of a finite grid or holds the blocking tile (coordinates wrap on infinite grids)
+template <typename T>
+bool ActorStore<T>::m_Blocked(const Grid& grid, const char blocking_char, const bool has_blocking, T x, T y) const
+{
+    const T n_rows{static_cast<T>(grid.NRows())};
+    const T n_cols{static_cast<T>(grid.NCols())};
+    if (grid.IsInfinite())
+    {
+        x = ((x % n_cols) + n_cols) % n_cols;
+        y = ((y % n_rows) + n_rows) % n_rows;
+    }
+    else if ((x < 0) || (y < 0) || (x >= n_cols) || (y >= n_rows))
+    {
+        return true;
+    }
+    return has_blocking && (grid(std::size_t(y), std::size_t(x)) == blocking_char);
+}
+
+}  // namespace commonlib
+
+#endif  // DATA_STRUCTURES_ACTOR_STORE_H
@@ -0,0 +1,346 @@
+/// @file bit_grid.h
+/// @author Alberto Santagostino
+
+#ifndef DATA_STRUCTURES_BIT_GRID_H
+#define DATA_STRUCTURES_BIT_GRID_H
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#ifdef TEST_BUILD
+#include <data_structures/grid.h>
+#else
+#include <commonlib/include/data_structures/grid.h>
+#endif
+
+namespace commonlib
+{
+/// @class BitGrid
+/// @brief Two-state grid packed as 1 bit per cell. Every row is stored as 64-bit words (bit c % 64 of word c / 64
+///        holds column c), so counting, shifting and boolean operations process 64 cells per instruction
+/// @details When built from a Grid, set bits are kTileType_Wall cells and clear bits kTileType_Empty cells
+class BitGrid
+{
+  public:
+    // Constructors
+    BitGrid(const std::size_t n_rows, const std::size_t n_cols);
+    BitGrid(const Grid& grid, const TilesMap& tiles);
+    explicit BitGrid(const Grid& grid) : BitGrid(grid, grid.GetTilesMap()) {}
+
+    // Getters / Setters
+    inline std::size_t NRows() const { return m_rows; }
+    inline std::size_t NCols() const { return m_cols; }
+    inline std::size_t WordsPerRow() const { return m_words_per_row; }
+    inline std::uint64_t* RowWords(const std::size_t row) { return m_words.data() + row * m_words_per_row; }
+    inline const std::uint64_t* RowWords(const std::size_t row) const
+    {
+        return m_words.data() + row * m_words_per_row;
+    }
+    bool Get(const std::size_t row, const std::size_t col) const;
+    void Set(const std::size_t row, const std::size_t col, const bool value = true);
+
+    // Counting
+    std::size_t Count() const;
+    std::size_t CountRow(const std::size_t row) const;
+
+    // Word-parallel operations
+    BitGrid Shifted(const long d_row, const long d_col) const;
+    BitGrid Dilated(const bool diagonals = true) const;
+    std::vector<std::uint8_t> NeighbourCounts(const bool diagonals = true) const;
+
+    // Conversion
+    Grid ToGrid(const TilesMap& tiles) const;
+
+    // Operators
+    BitGrid& operator&=(const BitGrid& other);
+    BitGrid& operator|=(const BitGrid& other);
+    BitGrid& operator^=(const BitGrid& other);
+    BitGrid operator~() const;
+    inline bool operator==(const BitGrid& other) const
+    {
+        return (m_rows == other.m_rows) && (m_cols == other.m_cols) && (m_words == other.m_words);
+    }
+    inline bool operator!=(const BitGrid& other) const { return !(*this == other); }
+
+  private:
+    std::size_t m_rows;
+    std::size_t m_cols;
+    std::size_t m_words_per_row;
+    std::vector<std::uint64_t> m_words;
+
+    void m_ClearPadding();
+    void m_CheckSize(const BitGrid& other) const;
+    static char m_TileChar(const TilesMap& tiles, const TileType tiletype);
+};
+
+/// @brief Constructor: all cells clear
+/// @param n_rows Number of rows
+/// @param n_cols Number of columns
+inline BitGrid::BitGrid(const std::size_t n_rows, const std::size_t n_cols)
+    : m_rows(n_rows), m_cols(n_cols), m_words_per_row((n_cols + 63U) / 64U), m_words(n_rows * m_words_per_row, 0U)
+{
+    if ((m_rows == 0) || (m_cols == 0))
+        throw std::length_error("BitGrid::BitGrid(n_rows, n_cols): Dimensions cannot be 0");
+}
+
+/// @brief Constructor: pack a two-state grid
+/// @param grid Grid to pack
+/// @param tiles Tile definitions, must define kTileType_Empty and kTileType_Wall
+/// @throw std::invalid_argument If the grid holds a character that is neither the empty nor the wall one
+inline BitGrid::BitGrid(const Grid& grid, const TilesMap& tiles) : BitGrid(grid.NRows(), grid.NCols())
+{
+    const char empty{m_TileChar(tiles, TileType::kTileType_Empty)};
+    const char wall{m_TileChar(tiles, TileType::kTileType_Wall)};
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        const char* cells = grid.data() + row * grid.RowStride();
+        std::uint64_t* words = RowWords(row);
+        for (std::size_t col{0U}; col < m_cols; ++col)
+        {
+            if (cells[col] == wall)
+                words[col / 64U] |= std::uint64_t{1} << (col % 64U);
+            else if (cells[col] != empty)
+                throw std::invalid_argument("BitGrid::BitGrid(grid, tiles): Grid is not made of empty and wall tiles");
+        }
+    }
+}
+
+inline bool BitGrid::Get(const std::size_t row, const std::size_t col) const
+{
+    if (row >= m_rows || col >= m_cols) throw std::out_of_range("BitGrid::Get(): Index is out of range");
+    return (RowWords(row)[col / 64U] >> (col % 64U)) & 1U;
+}
+
+inline void BitGrid::Set(const std::size_t row, const std::size_t col, const bool value)
+{
+    if (row >= m_rows || col >= m_cols) throw std::out_of_range("BitGrid::Set(): Index is out of range");
+    const std::uint64_t bit{std::uint64_t{1} << (col % 64U)};
+    std::uint64_t& word = RowWords(row)[col / 64U];
+    word = value ? (word | bit) : (word & ~bit);
+}
+
+/// @brief Number of set cells
+inline std::size_t BitGrid::Count() const
+{
+    std::size_t count{0U};
+    for (const auto word : m_words)
+        count += static_cast<std::size_t>(__builtin_popcountll(word));
+    return count;
+}
+
+/// @brief Number of set cells of a row
+inline std::size_t BitGrid::CountRow(const std::size_t row) const
+{
+    std::size_t count{0U};
+    const std::uint64_t* words = RowWords(row);
+    for (std::size_t w{0U}; w < m_words_per_row; ++w)
+        count += static_cast<std::size_t>(__builtin_popcountll(words[w]));
+    return count;
+}
+
+/// @brief Return a copy where cell (r, c) is moved to (r + d_row, c + d_col). Cells moved out are lost, cells
+///        entering from the borders are clear
+inline BitGrid BitGrid::Shifted(const long d_row, const long d_col) const
+{
+    BitGrid out(m_rows, m_cols);
+    const std::size_t abs_col{static_cast<std::size_t>((d_col < 0) ? -d_col : d_col)};
+    const std::size_t word_shift{abs_col / 64U};
+    const unsigned bit_shift{static_cast<unsigned>(abs_col % 64U)};
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        const long src_row{static_cast<long>(row) - d_row};
+        if ((src_row < 0) || (src_row >= static_cast<long>(m_rows))) continue;
+        const std::uint64_t* src = RowWords(static_cast<std::size_t>(src_row));
+        std::uint64_t* dst = out.RowWords(row);
+        for (std::size_t w{0U}; w < m_words_per_row; ++w)
+        {
+            std::uint64_t value{0U};
+            if (d_col >= 0)
+            {
+                // Towards higher columns: bits move up, carrying from the lower word
+                if (w >= word_shift)
+                {
+                    value = src[w - word_shift] << bit_shift;
+                    if ((bit_shift != 0U) && (w > word_shift)) value |= src[w - word_shift - 1U] >> (64U - bit_shift);
+                }
+            }
+            else
+            {
+                // Towards lower columns: bits move down, carrying from the higher word
+                if (w + word_shift < m_words_per_row)
+                {
+                    value = src[w + word_shift] >> bit_shift;
+                    if ((bit_shift != 0U) && (w + word_shift + 1U < m_words_per_row))
+                        value |= src[w + word_shift + 1U] << (64U - bit_shift);
+                }
+            }
+            dst[w] = value;
+        }
+    }
+    out.m_ClearPadding();
+    return out;
+}
+
+/// @brief Return a copy where every cell is set if itself or any of its neighbours is set
+/// @param diagonals Use 8-connectivity (true) or 4-connectivity (false)
+inline BitGrid BitGrid::Dilated(const bool diagonals) const
+{
+    BitGrid horizontal(*this);
+    horizontal |= Shifted(0, 1);
+    horizontal |= Shifted(0, -1);
+    BitGrid out(diagonals ? horizontal : *this);
+    out |= (diagonals ? horizontal : *this).Shifted(1, 0);
+    out |= (diagonals ? horizontal : *this).Shifted(-1, 0);
+    if (!diagonals) out |= horizontal;
+    return out;
+}
+
+/// @brief Number of set neighbours of every cell (row-major), computed with word-parallel adders over the shifted
+///        planes
+/// @param diagonals Use 8-connectivity (true) or 4-connectivity (false)
+inline std::vector<std::uint8_t> BitGrid::NeighbourCounts(const bool diagonals) const
+{
+    std::vector<BitGrid> planes;
+    for (long dr{-1}; dr <= 1; ++dr)
+    {
+        for (long dc{-1}; dc <= 1; ++dc)
+        {
+            if ((dr == 0) && (dc == 0)) continue;
+            if (!diagonals && (dr != 0) && (dc != 0)) continue;
+            planes.push_back(Shifted(dr, dc));
+        }
+    }
+    // Bit-sliced counter: sum bit k of every cell is stored in counter[k]
+    std::vector<std::uint64_t> counter[4];
+    for (auto& bits : counter)
+        bits.assign(m_words.size(), 0U);
+    for (const auto& plane : planes)
+    {
+        for (std::size_t w{0U}; w < m_words.size(); ++w)
+        {
+            std::uint64_t carry{plane.m_words[w]};
+            for (auto& bits : counter)
+            {
+                const std::uint64_t next_carry{bits[w] & carry};
+                bits[w] ^= carry;
+                carry = next_carry;
+            }
+        }
+    }
+    std::vector<std::uint8_t> counts(m_rows * m_cols, 0U);
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        for (std::size_t col{0U}; col < m_cols; ++col)
+        {
+            const std::size_t w{row * m_words_per_row + col / 64U};
+            const unsigned bit{static_cast<unsigned>(col % 64U)};
+            std::uint8_t value{0U};
+            for (unsigned k{0U}; k < 4U; ++k)
+                value |= static_cast<std::uint8_t>(((counter[k][w] >> bit) & 1U) << k);
+            counts[row * m_cols + col] = value;
+        }
+    }
+    return counts;
+}
+
+/// @brief Unpack to a Grid of empty and wall characters
+/// @param tiles Tile definitions, must define kTileType_Empty and kTileType_Wall
+inline Grid BitGrid::ToGrid(const TilesMap& tiles) const
+{
+    const char empty{m_TileChar(tiles, TileType::kTileType_Empty)};
+    const char wall{m_TileChar(tiles, TileType::kTileType_Wall)};
+    Grid grid(m_rows, m_cols, empty);
+    for (const auto& [tiletype, character] : tiles)
+        grid.AddTileTypeDefinition(tiletype, character);
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        const std::uint64_t* words = RowWords(row);
+        char* cells = grid.data() + row * grid.RowStride();
+        for (std::size_t w{0U}; w < m_words_per_row; ++w)
+        {
+            std::uint64_t word{words[w]};
+            while (word != 0U)
+            {
+                cells[w * 64U + static_cast<std::size_t>(__builtin_ctzll(word))] = wall;
+                word &= word - 1U;
+            }
+        }
+    }
+    return grid;
+}
+
+inline BitGrid& BitGrid::operator&=(const BitGrid& other)
+{
+    m_CheckSize(other);
+    for (std::size_t w{0U}; w < m_words.size(); ++w)
+        m_words[w] &= other.m_words[w];
+    return *this;
+}
+
+inline BitGrid& BitGrid::operator|=(const BitGrid& other)
+{
+    m_CheckSize(other);
+    for (std::size_t w{0U}; w < m_words.size(); ++w)
+        m_words[w] |= other.m_words[w];
+    return *this;
+}
+
+inline BitGrid& BitGrid::operator^=(const BitGrid& other)
+{
+    m_CheckSize(other);
+    for (std::size_t w{0U}; w < m_words.size(); ++w)
+        m_words[w] ^= other.m_words[w];
+    return *this;
+}
+
+inline BitGrid BitGrid::operator~() const
+{
+    BitGrid out(*this);
+    for (auto& word : out.m_words)
+        word = ~word;
+    out.m_ClearPadding();
+    return out;
+}
+
+/// @brief Clear the unused bits after the last column of every row, so that counts and comparisons stay exact
+inline void BitGrid::m_ClearPadding()
+{
+    if (m_cols % 64U == 0U) return;
+    const std::uint64_t mask{(std::uint64_t{1} << (m_cols % 64U)) - 1U};
+    for (std::size_t row{0U}; row < m_rows; ++row)
+        RowWords(row)[m_words_per_row - 1U] &= mask;
+}
+
+inline void BitGrid::m_CheckSize(const BitGrid& other) const
+{
+    if ((m_rows != other.m_rows) || (m_cols != other.m_cols))
+        throw std::length_error("BitGrid: Operands must have the same dimensions");
+}
+
+inline char BitGrid::m_TileChar(const TilesMap& tiles, const TileType tiletype)
+{
+    const auto it = tiles.find(tiletype);
+    if (it == tiles.end())
+        throw std::invalid_argument("BitGrid: Tiles map must define kTileType_Empty and kTileType_Wall");
+    return it->second;
+}
+
+inline BitGrid operator&(BitGrid lhs, const BitGrid& rhs)
+{
+    return lhs &= rhs;
+}
+
+inline BitGrid operator|(BitGrid lhs, const BitGrid& rhs)
+{
+    return lhs |= rhs;
+}
+
+inline BitGrid operator^(BitGrid lhs, const BitGrid& rhs)
+{
+    return lhs ^= rhs;
+}
+
+}  // namespace commonlib
+
+#endif  // DATA_STRUCTURES_BIT_GRID_H
@@ -0,0 +1,117 @@
+/// @file fixed_matrix.h
+/// @author Alberto Santagostino
+
+#ifndef DATA_STRUCTURES_FIXED_MATRIX_H
+#define DATA_STRUCTURES_FIXED_MATRIX_H
+
+#include <array>
+#include <cstddef>
+#include <initializer_list>
+#include <stdexcept>
+
+#ifdef TEST_BUILD
+#include <data_structures/matrix_view.h>
+#include <utils/bounds_check.h>
+#else
+#include <commonlib/include/data_structures/matrix_view.h>
+#include <commonlib/include/utils/bounds_check.h>
+#endif
+
+namespace commonlib
+{
+/// @class FixedMatrix
+/// @brief 2D matrix whose dimensions are known at compile time, stored row-major in a std::array (no allocation,
+///        usable in constant expressions). Returned by Matrix::CutWindow<W>() for small kernels
+/// @tparam T Type of data stored
+/// @tparam Rows Number of rows
+/// @tparam Cols Number of columns
+/// @tparam BoundsCheck Bounds-check policy of operator() (see utils/bounds_check.h)
+template <typename T, std::size_t Rows, std::size_t Cols, typename BoundsCheck = DefaultBoundsCheck>
+class FixedMatrix
+{
+    static_assert((Rows > 0U) && (Cols > 0U), "FixedMatrix dimensions cannot be 0");
+
+  public:
+    using value_type = T;
+
+    // Constructors
+    constexpr FixedMatrix() = default;
+    constexpr explicit FixedMatrix(const T init_value) { Fill(init_value); }
+    constexpr FixedMatrix(std::initializer_list<std::initializer_list<T>> matrix);
+
+    // Getters
+    static constexpr std::size_t NRows() { return Rows; }
+    static constexpr std::size_t NCols() { return Cols; }
+    static constexpr std::size_t Size() { return Rows * Cols; }
+    static constexpr std::size_t RowStride() { return Cols; }
+    static constexpr bool IsSquare() { return Rows == Cols; }
+    constexpr T* data() { return m_data.data(); }
+    constexpr const T* data() const { return m_data.data(); }
+    inline MatrixView<T> View() { return MatrixView<T>(m_data.data(), Rows, Cols, Cols); }
+    inline MatrixView<const T> View() const { return MatrixView<const T>(m_data.data(), Rows, Cols, Cols); }
+    inline MatrixView<const T> Data() const { return View(); }
+
+    // Bulk operations
+    constexpr std::size_t CountElements(const T searched_element) const;
+    constexpr void Fill(const T value);
+
+    // Operators (operator() checks the indices according to BoundsCheck, operator[] never does: matrix[row][col])
+    constexpr T& operator()(const std::size_t row, const std::size_t col)
+    {
+        BoundsCheck::Check((row < Rows) && (col < Cols), "FixedMatrix<T>::operator(): Index is out of range");
+        return m_data[row * Cols + col];
+    }
+    constexpr T const& operator()(const std::size_t row, const std::size_t col) const
+    {
+        BoundsCheck::Check((row < Rows) && (col < Cols), "FixedMatrix<T>::operator(): Index is out of range");
+        return m_data[row * Cols + col];
+    }
+    constexpr T* operator[](const std::size_t row) { return m_data.data() + row * Cols; }
+    constexpr const T* operator[](const std::size_t row) const { return m_data.data() + row * Cols; }
+    constexpr bool operator==(const FixedMatrix& other) const { return m_data == other.m_data; }
+    constexpr bool operator!=(const FixedMatrix& other) const { return !(*this == other); }
+
+  private:
+    std::array<T, Rows * Cols> m_data{};
+};
+
+/// @brief Constructor: initialize the matrix from its rows
+/// @param matrix Rows of the matrix
+/// @throw std::length_error If the number of rows or columns does not match Rows and Cols
+template <typename T, std::size_t Rows, std::size_t Cols, typename BoundsCheck>
+constexpr FixedMatrix<T, Rows, Cols, BoundsCheck>::FixedMatrix(std::initializer_list<std::initializer_list<T>> matrix)
+{
+    if (matrix.size() != Rows)
+        throw std::length_error("FixedMatrix<T>::FixedMatrix(matrix): Size not coherent with the number of rows");
+    std::size_t i{0U};
+    for (const std::initializer_list<T>& row : matrix)
+    {
+        if (row.size() != Cols)
+            throw std::length_error("FixedMatrix<T>::FixedMatrix(matrix): Size not coherent, all rows must have the same length");
+        for (const T& value : row)
+            m_data[i++] = value;
+    }
+}
+
+/// @brief Count and return the number of occurrences of the specified element
+/// @param searched_element Element to count
+template <typename T, std::size_t Rows, std::size_t Cols, typename BoundsCheck>
+constexpr std::size_t FixedMatrix<T, Rows, Cols, BoundsCheck>::CountElements(const T searched_element) const
+{
+    std::size_t matches{0U};
+    for (const T& value : m_data)
+        matches += static_cast<std::size_t>(value == searched_element);
+    return matches;
+}
+
+/// @brief Set every element to the same value
+template <typename T, std::size_t Rows, std::size_t Cols, typename BoundsCheck>
+constexpr void FixedMatrix<T, Rows, Cols, BoundsCheck>::Fill(const T value)
+{
+    for (T& element : m_data)
+        element = value;
+}
+
+}  // namespace commonlib
+
+#endif  // DATA_STRUCTURES_FIXED_MATRIX_H
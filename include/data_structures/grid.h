@@ -5,8 +5,19 @@
 #define DATA_STRUCTURES_GRID_H
 
 #include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <memory>
 #include <optional>
+#include <stdexcept>
+#include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #ifdef TEST_BUILD
 #include <data_structures/matrix.h>
@@ -29,6 +40,9 @@ enum class TileType
 typedef std::unordered_map<std::size_t, Actor> ActorsMap;
 typedef std::unordered_map<TileType, char> TilesMap;
 
+/// @brief Number of TileType values (kTileType_Undefined included)
+inline constexpr std::size_t kNTileTypes{static_cast<std::size_t>(TileType::kTileType_Undefined) + 1U};
+
 /// @class Grid
 /// @brief 2D characters grid, inherited as Matrix<char>. It holds a number of actors
 class Grid : public Matrix<char>
@@ -36,32 +50,465 @@ class Grid : public Matrix<char>
   public:
     // Constructors
     using Matrix::Matrix;
+    explicit Grid(std::shared_ptr<MappedFile> file);
 
     // Grid-specific setters
     bool AddActor(Actor actor);
+    bool RemoveActor(const std::size_t actor_id);
+    bool MoveActor(const std::size_t actor_id, const Position<std::size_t> position);
     bool AddTileTypeDefinition(TileType tiletype, char character);
     bool ActorExists(const std::size_t actor_id);
     inline void MakeInfinite(const bool infinite) { m_infinite = infinite; }
 
+    // Structural edits (actors move with their cells, the actors on a removed row or column are removed)
+    void InsertRow(const std::size_t index, const std::vector<char>& new_row = {});
+    void InsertRow(const std::size_t index, RowView<const char> new_row);
+    void InsertColumn(const std::size_t index, const std::vector<char>& new_col = {});
+    void InsertColumn(const std::size_t index, ColumnView<const char> new_col);
+    void RemoveRow(const std::size_t index);
+    void RemoveColumn(const std::size_t index);
+    void ApplyEdits(const MatrixEdits<char>& edits);
+
     // Grid-specific getters
+    inline bool IsInfinite() const { return m_infinite; }
     inline const ActorsMap GetActors() { return m_actors; }
     bool GetActor(const std::size_t actor_id);
     bool GetActor(const std::size_t actor_id, Actor& actor);
-    const TileType GetTileType(std::size_t row, std::size_t col);
+    const TileType GetTileType(std::size_t row, std::size_t col) const;
+    inline TileType GetTileType(const char character) const
+    {
+        return m_tile_of_char[static_cast<unsigned char>(character)];
+    }
+    inline const TilesMap& GetTilesMap() const { return m_tiles; }
+
+    // Materialized tile plane
+    void MaterializeTiles(const bool enable);
+    inline bool HasTilePlane() const { return m_plane.enabled; }
+    void RebuildTilePlane();
+    std::size_t CountTiles(const TileType tiletype) const;
+    const std::vector<Position<std::size_t>>& TilePositions(const TileType tiletype) const;
+
+    // Per-value prefix counts (rectangles are bounds included, clamped to the grid)
+    void IndexValues(const std::vector<char>& values);
+    inline bool IsValueIndexed(const char value) const
+    {
+        return m_counts.plane_of[static_cast<unsigned char>(value)] != kNoPlane;
+    }
+    void RebuildValueIndex();
+    std::size_t CountInRectangle(const char value,
+                                 const std::size_t first_row,
+                                 const std::size_t first_col,
+                                 const std::size_t last_row,
+                                 const std::size_t last_col) const;
+
+    // Incremental Zobrist hash of the cells
+    void EnableHashing(const bool enable);
+    inline bool IsHashing() const { return m_hash.enabled; }
+    void RehashCells();
+    std::uint64_t Hash() const;
+
+    // Actors spatial queries (positions are x = column, y = row)
+    bool IsOccupied(const std::size_t row, const std::size_t col) const;
+    std::vector<std::size_t> ActorsAt(const std::size_t row, const std::size_t col) const;
+    std::vector<std::size_t> ActorsInRectangle(const std::size_t first_row, const std::size_t first_col,
+                                               const std::size_t last_row, const std::size_t last_col) const;
+    std::vector<std::size_t> ActorsInRadius(const std::size_t row, const std::size_t col, const double radius) const;
 
-    // Operators
-    char& operator()(std::size_t row, std::size_t col);
+    // Change tracking
+    void TrackChanges(const bool enable);
+    void MarkAllActive();
+    std::size_t CommitChanges();
+    std::vector<std::pair<std::size_t, std::size_t>> ActiveCells(const std::size_t radius = 1U,
+                                                                 const bool wrap = false) const;
+    inline bool IsTrackingChanges() const { return m_tracking; }
+    inline bool AllCellsActive() const { return m_all_active; }
+    inline const std::vector<std::pair<std::size_t, std::size_t>>& ChangedCells() const { return m_changed; }
+    inline bool IsFixedPoint() const { return m_tracking && (m_commits > 0U) && !m_all_active && m_changed.empty(); }
+
+    // Binary snapshots (grid, tiles definitions, actors and infinite flag)
+    void SaveSnapshot(std::ostream& out) const;
+    void SaveSnapshot(const std::string& path) const;
+    static Grid LoadSnapshot(std::shared_ptr<MappedFile> file, const bool verify_checksum = true);
+
+    // Operators (reading a cell through the non-const operator() is a plain load, only assignments are logged)
+    class CellRef;
+    CellRef operator()(std::size_t row, std::size_t col);
     char const& operator()(std::size_t row, std::size_t col) const;
 
   private:
+    Grid() = default;
+
     ActorsMap m_actors;
     TilesMap m_tiles;
-    bool m_infinite;
+    std::array<TileType, 256U> m_tile_of_char{m_UndefinedTiles()};
+    bool m_infinite{false};
+
+    // Tile plane: the TileType of every cell, with the positions of the cells of each type. Writes through
+    // operator() only flag the cell, the plane is synchronized on the next query
+    struct TilePlane
+    {
+        bool enabled{false};
+        bool stale{true};  ///< Needs a full rebuild
+        std::size_t n_rows{0U};
+        std::size_t n_cols{0U};
+        std::uint64_t modifications{0U};  ///< Matrix::Modifications() when last rebuilt
+        std::vector<std::uint8_t> types;  ///< Per cell, TileType of the cell
+        std::vector<std::uint32_t> slot;  ///< Per cell, index of the cell in positions[type]
+        std::array<std::vector<Position<std::size_t>>, kNTileTypes> positions;
+        std::vector<std::uint8_t> dirty;     ///< Per cell, 1 if in pending
+        std::vector<std::uint32_t> pending;  ///< Cells written since the last synchronization
+    };
+    mutable TilePlane m_plane;
+
+    static std::array<TileType, 256U> m_UndefinedTiles();
+    void m_SyncTilePlane() const;
+    inline void m_MarkTileDirty(const std::size_t row, const std::size_t col)
+    {
+        const std::size_t cell{row * m_cols + col};
+        if ((cell < m_plane.dirty.size()) && (m_plane.dirty[cell] == 0U))
+        {
+            m_plane.dirty[cell] = 1U;
+            m_plane.pending.push_back(static_cast<std::uint32_t>(cell));
+        }
+    }
+
+    // Value count planes: per indexed value, the (rows + 1) x (cols + 1) prefix counts of its cells. Writes through
+    // operator() are kept as pending cells (with their value before the first write), folded into a per-plane 2D
+    // Fenwick tree of count deltas on the next query, until there are too many of them and the planes are rebuilt
+    static constexpr std::uint8_t kNoPlane{std::numeric_limits<std::uint8_t>::max()};
+    struct CountPlanes
+    {
+        bool enabled{false};
+        bool stale{true};  ///< Needs a full rebuild
+        std::size_t n_rows{0U};
+        std::size_t n_cols{0U};
+        std::uint64_t modifications{0U};  ///< Matrix::Modifications() when last rebuilt
+        std::array<std::uint8_t, 256U> plane_of{m_NoPlanes()};  ///< Per character, index of its plane
+        std::vector<char> values;                                ///< Per plane, indexed value
+        std::vector<std::vector<std::uint32_t>> prefix;          ///< Per plane, prefix counts
+        std::vector<std::vector<std::int32_t>> tree;             ///< Per plane, Fenwick tree of the folded writes
+        std::size_t n_folded{0U};                                ///< Writes folded in the trees since the rebuild
+        std::vector<std::uint8_t> dirty;                         ///< Per cell, 1 if in pending
+        std::vector<std::pair<std::uint32_t, char>> pending;     ///< (cell, value before the first write)
+    };
+    mutable CountPlanes m_counts;
+
+    static std::array<std::uint8_t, 256U> m_NoPlanes();
+    void m_SyncCountPlanes() const;
+    std::ptrdiff_t m_FoldedCount(const std::uint8_t plane, const std::size_t row, const std::size_t col) const;
+    inline void m_MarkCountDirty(const std::size_t row, const std::size_t col)
+    {
+        const std::size_t cell{row * m_cols + col};
+        if ((cell < m_counts.dirty.size()) && (m_counts.dirty[cell] == 0U))
+        {
+            m_counts.dirty[cell] = 1U;
+            m_counts.pending.emplace_back(static_cast<std::uint32_t>(cell), m_data[m_Index(row, col)]);
+        }
+    }
+
+    // Zobrist hash: XOR over the cells of a 64-bit key per (cell, value). Writes through operator() are kept as pending
+    // cells (with their value when the hash was last updated), each one is folded in with two XORs on the next query
+    struct CellHash
+    {
+        bool enabled{false};
+        bool stale{true};  ///< Needs a full rehash
+        std::size_t n_rows{0U};
+        std::size_t n_cols{0U};
+        std::uint64_t modifications{0U};  ///< Matrix::Modifications() when last rehashed
+        std::uint64_t value{0U};
+        std::vector<std::uint8_t> dirty;                      ///< Per cell, 1 if in pending
+        std::vector<std::pair<std::uint32_t, char>> pending;  ///< (cell, value when the hash was last updated)
+    };
+    mutable CellHash m_hash;
+
+    static std::uint64_t m_ZobristKey(const std::size_t cell, const char value);
+    std::uint64_t m_FullHash() const;
+    inline void m_MarkHashDirty(const std::size_t row, const std::size_t col)
+    {
+        const std::size_t cell{row * m_cols + col};
+        if ((cell < m_hash.dirty.size()) && (m_hash.dirty[cell] == 0U))
+        {
+            m_hash.dirty[cell] = 1U;
+            m_hash.pending.emplace_back(static_cast<std::uint32_t>(cell), m_data[m_Index(row, col)]);
+        }
+    }
+
+    // Actors spatial index: one doubly-linked list of actor slots per cell, so that occupancy checks, moves and
+    // removals are O(1) and region queries only visit the cells of the region
+    static constexpr std::uint32_t kNoSlot{std::numeric_limits<std::uint32_t>::max()};
+    struct ActorSlot
+    {
+        std::size_t id;
+        std::size_t cell;
+        std::uint32_t prev;
+        std::uint32_t next;
+    };
+    struct ActorIndex
+    {
+        std::size_t n_rows{0U};
+        std::size_t n_cols{0U};
+        std::vector<std::uint32_t> cell_head;  ///< Per cell, first actor slot (kNoSlot if empty)
+        std::vector<ActorSlot> slots;
+        std::vector<std::uint32_t> free_slots;
+        std::unordered_map<std::size_t, std::uint32_t> slot_of;  ///< Actor id -> slot
+    };
+    mutable ActorIndex m_index;  ///< Rebuilt from the actor positions when the grid is resized
+
+    const ActorIndex& m_ActorIndex() const;
+    std::size_t m_ActorCell(const Position<std::size_t>& position) const;
+    void m_Link(const std::uint32_t slot, const std::size_t cell) const;
+    void m_Unlink(const std::uint32_t slot) const;
+    void m_RemapActors(std::vector<std::size_t> row_inserts,
+                       std::vector<std::size_t> row_removals,
+                       std::vector<std::size_t> col_inserts,
+                       std::vector<std::size_t> col_removals);
+
+    // Change tracking: every cell written through operator() is logged once (with its previous value) until the next
+    // commit, which keeps the cells whose value actually changed
+    bool m_tracking{false};
+    bool m_all_active{false};  ///< No change set is known (tracking just enabled, grid resized, MarkAllActive)
+    std::size_t m_tracked_rows{0U};
+    std::size_t m_tracked_cols{0U};
+    std::size_t m_commits{0U};
+    std::vector<std::uint8_t> m_logged;                         ///< Per cell, 1 if already in m_write_log
+    std::vector<std::pair<std::size_t, char>> m_write_log;      ///< (cell index, value before the first write)
+    std::vector<std::pair<std::size_t, std::size_t>> m_changed;  ///< Cells changed before the last commit
+    mutable std::vector<std::uint8_t> m_active_mark;             ///< Scratch of ActiveCells(), always left cleared
+
+    void m_ResetTracking();
+    void m_MarkWrite(const std::size_t row, const std::size_t col);
+    inline void m_LogWrite(const std::size_t row, const std::size_t col)
+    {
+        const std::size_t cell{row * m_cols + col};
+        if ((cell < m_logged.size()) && (m_logged[cell] == 0U))
+        {
+            m_logged[cell] = 1U;
+            m_write_log.emplace_back(cell, m_data[m_Index(row, col)]);
+        }
+    }
+};
+
+/// @class Grid::CellRef
+/// @brief Cell returned by the non-const Grid::operator(): it converts to the value of the cell, every write through it
+///        (assignment, compound assignment, increment, swap) notifies the change tracking and the grid indexes (tile
+///        plane, value counts, hash) before storing the new value
+/// @details Being a proxy, it cannot bind to a char& nor give the address of the cell (use data() or operator[] for
+///          raw, unlogged access), and auto deduces the proxy: write char value = grid(row, col) to copy the value.
+///          Swap two cells with an unqualified swap (using std::swap; swap(grid(a, b), grid(c, d));)
+class Grid::CellRef
+{
+  public:
+    using value_type = char;
+
+    CellRef(const CellRef&) = default;
+    inline operator char() const { return *m_cell; }
+    inline CellRef& operator=(const char value)
+    {
+        m_grid.m_MarkWrite(m_row, m_col);
+        *m_cell = value;
+        return *this;
+    }
+    inline CellRef& operator=(const CellRef& other) { return *this = static_cast<char>(other); }
+
+    // Compound assignments and increments, logged as writes
+    inline CellRef& operator+=(const char value) { return *this = static_cast<char>(*m_cell + value); }
+    inline CellRef& operator-=(const char value) { return *this = static_cast<char>(*m_cell - value); }
+    inline CellRef& operator*=(const char value) { return *this = static_cast<char>(*m_cell * value); }
+    inline CellRef& operator/=(const char value) { return *this = static_cast<char>(*m_cell / value); }
+    inline CellRef& operator%=(const char value) { return *this = static_cast<char>(*m_cell % value); }
+    inline CellRef& operator&=(const char value) { return *this = static_cast<char>(*m_cell & value); }
+    inline CellRef& operator|=(const char value) { return *this = static_cast<char>(*m_cell | value); }
+    inline CellRef& operator^=(const char value) { return *this = static_cast<char>(*m_cell ^ value); }
+    inline CellRef& operator<<=(const int shift) { return *this = static_cast<char>(*m_cell << shift); }
+    inline CellRef& operator>>=(const int shift) { return *this = static_cast<char>(*m_cell >> shift); }
+    inline CellRef& operator++() { return *this += 1; }
+    inline CellRef& operator--() { return *this -= 1; }
+    inline char operator++(int)
+    {
+        const char old_value{*m_cell};
+        ++*this;
+        return old_value;
+    }
+    inline char operator--(int)
+    {
+        const char old_value{*m_cell};
+        --*this;
+        return old_value;
+    }
+
+    // Swaps, found by argument-dependent lookup
+    friend inline void swap(CellRef a, CellRef b)
+    {
+        const char value{a};
+        a = static_cast<char>(b);
+        b = value;
+    }
+    friend inline void swap(CellRef a, char& b)
+    {
+        const char value{a};
+        a = b;
+        b = value;
+    }
+    friend inline void swap(char& a, CellRef b) { swap(b, a); }
+
+  private:
+    friend class Grid;
+    CellRef(Grid& grid, const std::size_t row, const std::size_t col, char* cell)
+        : m_grid(grid), m_row(row), m_col(col), m_cell(cell)
+    {
+    }
+
+    Grid& m_grid;
+    const std::size_t m_row;
+    const std::size_t m_col;
+    char* m_cell;
 };
 
+/// @brief Constructor: borrow the rows of a mapped file as storage, without copying them
+/// @details The file must contain one row per line without separators ('\0' row_sep format) and use the same line
+///          terminator ("\n" or "\r\n") everywhere; the grid keeps the mapping alive. Writes go to the private
+///          copy-on-write pages and never reach the file. Any resize moves the grid to an owned buffer
+/// @param file Mapped file to borrow
+/// @throw std::length_error If the file is empty or its rows are not laid out with a constant stride
+inline Grid::Grid(std::shared_ptr<MappedFile> file)
+{
+    char* begin = file->Data();
+    char* end = begin + file->Size();
+    const char* first_newline = m_LineEnd(begin, end);
+    const std::size_t terminator{((first_newline > begin) && (first_newline[-1] == '\r')) ? 2U : 1U};
+    const std::size_t n_cols{static_cast<std::size_t>(first_newline - begin) + 1U - terminator};
+    const std::size_t stride{n_cols + terminator};
+    if ((begin == end) || (n_cols == 0U))
+        throw std::length_error("Grid::Grid(file): Dimensions cannot be 0");
+
+    std::size_t n_rows{0U};
+    char* row = begin;
+    while ((row < end) && (*row != '\n') && (*row != '\r'))
+    {
+        char* newline = const_cast<char*>(m_LineEnd(row, end));
+        const std::size_t length{static_cast<std::size_t>(newline - row)};
+        if (newline == end)
+        {
+            // Last row, not terminated
+            if (length != n_cols)
+                throw std::length_error("Grid::Grid(file): Size not coherent, all rows must have the same length");
+            ++n_rows;
+            row = end;
+            break;
+        }
+        if ((length != stride - 1U) || ((terminator == 2U) && (newline[-1] != '\r')))
+            throw std::length_error("Grid::Grid(file): Size not coherent, all rows must have the same length");
+        ++n_rows;
+        row = newline + 1;
+    }
+    // Only empty lines can follow the last row
+    for (; row < end; ++row)
+    {
+        if ((*row != '\n') && (*row != '\r'))
+            throw std::length_error("Grid::Grid(file): Size not coherent, all rows must have the same length");
+    }
+
+    m_data = begin;
+    m_rows = n_rows;
+    m_cols = n_cols;
+    m_row_stride = stride;
+    m_owner = std::move(file);
+}
+
+/// @brief Write a binary snapshot of the grid. After the characters come the metadata: infinite flag (u8), number
+///        of tile definitions (u32) and (tiletype u32, character u8) pairs, number of actors (u64) and
+///        (id u64, character u8, x u64, y u64) tuples
+/// @param out Binary output stream
+/// @throw std::ios_base::failure If the snapshot cannot be written
+inline void Grid::SaveSnapshot(std::ostream& out) const
+{
+    std::string metadata;
+    auto put = [&metadata](const auto value) {
+        metadata.append(reinterpret_cast<const char*>(&value), sizeof(value));
+    };
+    put(static_cast<std::uint8_t>(m_infinite));
+    put(static_cast<std::uint32_t>(m_tiles.size()));
+    for (const auto& [tiletype, character] : m_tiles)
+    {
+        put(static_cast<std::uint32_t>(tiletype));
+        put(static_cast<std::uint8_t>(character));
+    }
+    put(static_cast<std::uint64_t>(m_actors.size()));
+    for (const auto& [id, stored] : m_actors)
+    {
+        put(static_cast<std::uint64_t>(id));
+        put(static_cast<std::uint8_t>(stored.GetCharacter()));
+        put(static_cast<std::uint64_t>(stored.GetPosition().x));
+        put(static_cast<std::uint64_t>(stored.GetPosition().y));
+    }
+    m_WriteSnapshot(out, SnapshotKind::kSnapshotKind_Grid, metadata);
+}
+
+/// @brief Write a binary snapshot of the grid to a file
+/// @param path Path of the file (overwritten)
+/// @throw std::ios_base::failure If the file cannot be written
+inline void Grid::SaveSnapshot(const std::string& path) const
+{
+    std::ofstream fp(path, std::ios::binary | std::ios::trunc);
+    if (!fp) throw std::ios_base::failure("Grid::SaveSnapshot(path): Cannot open file");
+    SaveSnapshot(fp);
+}
+
+/// @brief Restore a grid from a snapshot: the characters are borrowed from the mapped file, only the tiles
+///        definitions and the actors are decoded. Snapshots of a Matrix<char> are restored as plain grids
+/// @param file Mapped snapshot, kept alive by the grid
+/// @param verify_checksum Whether to verify the checksum (one read-only pass over the mapped bytes)
+/// @throw std::invalid_argument If the file is not a valid snapshot of a Grid or Matrix<char>
+/// @throw std::length_error If the snapshot records 0 rows or 0 columns
+inline Grid Grid::LoadSnapshot(std::shared_ptr<MappedFile> file, const bool verify_checksum)
+{
+    const char* metadata = file->Data() + sizeof(SnapshotHeader);
+    Grid grid;
+    const SnapshotHeader header = grid.m_BorrowSnapshot(std::move(file), verify_checksum);
+    if (header.kind != SnapshotKind::kSnapshotKind_Grid) return grid;
+
+    const char* cursor = metadata + header.data_size;
+    const char* end = cursor + header.metadata_size;
+    auto get = [&cursor, end](auto& value) {
+        if (static_cast<std::size_t>(end - cursor) < sizeof(value))
+            throw std::invalid_argument("Grid::LoadSnapshot(file): Truncated metadata");
+        std::memcpy(&value, cursor, sizeof(value));
+        cursor += sizeof(value);
+    };
+    std::uint8_t infinite;
+    std::uint32_t n_tiles;
+    get(infinite);
+    get(n_tiles);
+    for (std::uint32_t i{0U}; i < n_tiles; ++i)
+    {
+        std::uint32_t tiletype;
+        std::uint8_t character;
+        get(tiletype);
+        get(character);
+        if ((tiletype >= kNTileTypes) ||
+            !grid.AddTileTypeDefinition(static_cast<TileType>(tiletype), static_cast<char>(character)))
+            throw std::invalid_argument("Grid::LoadSnapshot(file): Invalid tile definition");
+    }
+    grid.MakeInfinite(infinite != 0U);
+    std::uint64_t n_actors;
+    get(n_actors);
+    for (std::uint64_t i{0U}; i < n_actors; ++i)
+    {
+        std::uint64_t id, x, y;
+        std::uint8_t character;
+        get(id);
+        get(character);
+        get(x);
+        get(y);
+        if (!grid.AddActor(Actor(id, character, Position<std::size_t>(x, y))))
+            throw std::invalid_argument("Grid::LoadSnapshot(file): Duplicated actor");
+    }
+    return grid;
+}
+
 /// @brief Check if a specific actor exists
 /// @param actor_id Id of the actor
-bool Grid::GetActor(const std::size_t actor_id)
+inline bool Grid::GetActor(const std::size_t actor_id)
 {
     ActorsMap::const_iterator got = m_actors.find(actor_id);
     return (got == m_actors.end()) ? (false) : (true);
@@ -70,7 +517,7 @@ bool Grid::GetActor(const std::size_t actor_id)
 /// @brief Return a specific actor
 /// @param actor_id Id of the actor
 /// @param actor Variable to fill with the desired actor
-bool Grid::GetActor(const std::size_t actor_id, Actor& actor)
+inline bool Grid::GetActor(const std::size_t actor_id, Actor& actor)
 {
     ActorsMap::iterator got = m_actors.find(actor_id);
     if (got == m_actors.end())
@@ -84,84 +531,805 @@ bool Grid::GetActor(const std::size_t actor_id, Actor& actor)
     }
 }
 
-/// @brief Get the tile type at the specific position
-const TileType Grid::GetTileType(std::size_t row, std::size_t col)
+/// @brief Get the tile type at the specific position, in O(1)
+inline const TileType Grid::GetTileType(std::size_t row, std::size_t col) const
 {
-    auto tile_char = this->operator()(row, col);
-    auto it = std::find_if(m_tiles.begin(), m_tiles.end(), [tile_char](auto& p) { return p.second == tile_char; });
-    if (it != m_tiles.end())
-    {
-        return it->first;
-    }
-    return TileType::kTileType_Undefined;
+    return GetTileType(this->operator()(row, col));
+}
+
+/// @brief Check if a specific actor exists
+/// @param actor_id Id of the actor
+inline bool Grid::ActorExists(const std::size_t actor_id)
+{
+    return GetActor(actor_id);
 }
 
-/// @brief Add an actor to the grid
+/// @brief Add an actor to the grid, at its position (wrapped on infinite grids)
 /// @param actor Actor to add
-bool Grid::AddActor(Actor actor)
+/// @throw std::out_of_range If the actor position is outside of a finite grid
+inline bool Grid::AddActor(Actor actor)
 {
     const std::size_t id = actor.Id();
     if (!GetActor(id))
     {
+        const std::size_t cell{m_ActorCell(actor.GetPosition())};
+        m_ActorIndex();
+        std::uint32_t slot;
+        if (m_index.free_slots.empty())
+        {
+            slot = static_cast<std::uint32_t>(m_index.slots.size());
+            m_index.slots.push_back(ActorSlot{id, cell, kNoSlot, kNoSlot});
+        }
+        else
+        {
+            slot = m_index.free_slots.back();
+            m_index.free_slots.pop_back();
+            m_index.slots[slot].id = id;
+        }
+        m_Link(slot, cell);
+        m_index.slot_of.emplace(id, slot);
+        actor.SetPosition(Position<std::size_t>(cell % m_cols, cell / m_cols));
         m_actors.insert(std::make_pair(id, actor));
         return true;
     }
     return false;
 }
 
+/// @brief Remove an actor from the grid
+/// @param actor_id Id of the actor
+inline bool Grid::RemoveActor(const std::size_t actor_id)
+{
+    const auto it = m_actors.find(actor_id);
+    if (it == m_actors.end()) return false;
+    m_ActorIndex();
+    const std::uint32_t slot{m_index.slot_of.at(actor_id)};
+    m_Unlink(slot);
+    m_index.free_slots.push_back(slot);
+    m_index.slot_of.erase(actor_id);
+    m_actors.erase(it);
+    return true;
+}
+
+/// @brief Insert a new row (see Matrix::InsertRow), the actors below it move down
+inline void Grid::InsertRow(const std::size_t index, const std::vector<char>& new_row)
+{
+    InsertRow(index, RowView<const char>(new_row));
+}
+
+/// @brief Insert a new row copied from a view (see Matrix::InsertRow), the actors below it move down
+inline void Grid::InsertRow(const std::size_t index, RowView<const char> new_row)
+{
+    Matrix::InsertRow(index, new_row);
+    m_RemapActors({index}, {}, {}, {});
+}
+
+/// @brief Insert a new column (see Matrix::InsertColumn), the actors on its right move right
+inline void Grid::InsertColumn(const std::size_t index, const std::vector<char>& new_col)
+{
+    InsertColumn(index, ColumnView<const char>(new_col));
+}
+
+/// @brief Insert a new column copied from a view (see Matrix::InsertColumn), the actors on its right move right
+inline void Grid::InsertColumn(const std::size_t index, ColumnView<const char> new_col)
+{
+    Matrix::InsertColumn(index, new_col);
+    m_RemapActors({}, {}, {index}, {});
+}
+
+/// @brief Remove a row (see Matrix::RemoveRow): the actors on it are removed, the actors below it move up
+inline void Grid::RemoveRow(const std::size_t index)
+{
+    Matrix::RemoveRow(index);
+    m_RemapActors({}, {index}, {}, {});
+}
+
+/// @brief Remove a column (see Matrix::RemoveColumn): the actors on it are removed, the actors on its right move left
+inline void Grid::RemoveColumn(const std::size_t index)
+{
+    Matrix::RemoveColumn(index);
+    m_RemapActors({}, {}, {}, {index});
+}
+
+/// @brief Apply a batch of structural edits (see Matrix::ApplyEdits): the actors move with their cells, the actors on
+///        a removed row or column are removed
+inline void Grid::ApplyEdits(const MatrixEdits<char>& edits)
+{
+    Matrix::ApplyEdits(edits);
+    std::vector<std::size_t> row_inserts;
+    std::vector<std::size_t> col_inserts;
+    for (const auto& [index, values] : edits.RowInserts())
+        row_inserts.push_back(index);
+    for (const auto& [index, values] : edits.ColumnInserts())
+        col_inserts.push_back(index);
+    m_RemapActors(std::move(row_inserts), edits.RowRemovals(), std::move(col_inserts), edits.ColumnRemovals());
+}
+
+/// @brief Move an actor to a new position (wrapped on infinite grids), in O(1)
+/// @param actor_id Id of the actor
+/// @param position New position
+/// @throw std::out_of_range If the position is outside of a finite grid
+inline bool Grid::MoveActor(const std::size_t actor_id, const Position<std::size_t> position)
+{
+    const auto it = m_actors.find(actor_id);
+    if (it == m_actors.end()) return false;
+    const std::size_t cell{m_ActorCell(position)};
+    m_ActorIndex();
+    const std::uint32_t slot{m_index.slot_of.at(actor_id)};
+    if (m_index.slots[slot].cell != cell)
+    {
+        m_Unlink(slot);
+        m_Link(slot, cell);
+    }
+    it->second.SetPosition(Position<std::size_t>(cell % m_cols, cell / m_cols));
+    return true;
+}
+
+/// @brief Check if at least one actor is on a cell, in O(1)
+inline bool Grid::IsOccupied(const std::size_t row, const std::size_t col) const
+{
+    const std::size_t cell{m_ActorCell(Position<std::size_t>(col, row))};
+    return m_ActorIndex().cell_head[cell] != kNoSlot;
+}
+
+/// @brief Ids of the actors on a cell
+inline std::vector<std::size_t> Grid::ActorsAt(const std::size_t row, const std::size_t col) const
+{
+    const std::size_t cell{m_ActorCell(Position<std::size_t>(col, row))};
+    const ActorIndex& index = m_ActorIndex();
+    std::vector<std::size_t> ids;
+    for (std::uint32_t slot{index.cell_head[cell]}; slot != kNoSlot; slot = index.slots[slot].next)
+        ids.push_back(index.slots[slot].id);
+    return ids;
+}
+
+/// @brief Ids of the actors in a rectangle (bounds included, clamped to the grid), row by row
+inline std::vector<std::size_t> Grid::ActorsInRectangle(const std::size_t first_row, const std::size_t first_col,
+                                                        const std::size_t last_row, const std::size_t last_col) const
+{
+    const ActorIndex& index = m_ActorIndex();
+    std::vector<std::size_t> ids;
+    if ((m_rows == 0U) || (m_cols == 0U)) return ids;
+    const std::size_t end_row{std::min(last_row, m_rows - 1U)};
+    const std::size_t end_col{std::min(last_col, m_cols - 1U)};
+    for (std::size_t row{first_row}; row <= end_row; ++row)
+    {
+        for (std::size_t col{first_col}; col <= end_col; ++col)
+        {
+            for (std::uint32_t slot{index.cell_head[row * m_cols + col]}; slot != kNoSlot; slot = index.slots[slot].next)
+                ids.push_back(index.slots[slot].id);
+        }
+    }
+    return ids;
+}
+
+/// @brief Ids of the actors whose cell is within a (euclidean) distance of a cell
+inline std::vector<std::size_t> Grid::ActorsInRadius(const std::size_t row, const std::size_t col,
+                                                     const double radius) const
+{
+    const ActorIndex& index = m_ActorIndex();
+    std::vector<std::size_t> ids;
+    if ((radius < 0.0) || (m_rows == 0U) || (m_cols == 0U)) return ids;
+    const std::size_t reach{static_cast<std::size_t>(std::floor(radius))};
+    const std::size_t first_row{(row > reach) ? (row - reach) : 0U};
+    const std::size_t first_col{(col > reach) ? (col - reach) : 0U};
+    const std::size_t end_row{std::min(row + reach, m_rows - 1U)};
+    const std::size_t end_col{std::min(col + reach, m_cols - 1U)};
+    for (std::size_t r{first_row}; r <= end_row; ++r)
+    {
+        const double d_row{double(r) - double(row)};
+        for (std::size_t c{first_col}; c <= end_col; ++c)
+        {
+            const double d_col{double(c) - double(col)};
+            if (d_row * d_row + d_col * d_col > radius * radius) continue;
+            for (std::uint32_t slot{index.cell_head[r * m_cols + c]}; slot != kNoSlot; slot = index.slots[slot].next)
+                ids.push_back(index.slots[slot].id);
+        }
+    }
+    return ids;
+}
+
+/// @brief Spatial index, rebuilt first if the grid has been resized since it was built
+inline const Grid::ActorIndex& Grid::m_ActorIndex() const
+{
+    if ((m_index.n_rows != m_rows) || (m_index.n_cols != m_cols))
+    {
+        m_index.n_rows = m_rows;
+        m_index.n_cols = m_cols;
+        m_index.cell_head.assign(m_rows * m_cols, kNoSlot);
+        for (const auto& [id, slot] : m_index.slot_of)
+        {
+            m_Link(slot, m_ActorCell(m_actors.at(id).GetPosition()));
+        }
+    }
+    return m_index;
+}
+
+/// @brief Update the actor positions after a structural edit, remove the actors on the removed rows and columns
+/// @param row_inserts, col_inserts Indices (before the edit) of the rows/columns the insertions were made before
+/// @param row_removals, col_removals Indices (before the edit) of the removed rows/columns
+inline void Grid::m_RemapActors(std::vector<std::size_t> row_inserts,
+                                std::vector<std::size_t> row_removals,
+                                std::vector<std::size_t> col_inserts,
+                                std::vector<std::size_t> col_removals)
+{
+    if (m_actors.empty()) return;
+    for (std::vector<std::size_t>* indices : {&row_inserts, &row_removals, &col_inserts, &col_removals})
+        std::sort(indices->begin(), indices->end());
+    row_removals.erase(std::unique(row_removals.begin(), row_removals.end()), row_removals.end());
+    col_removals.erase(std::unique(col_removals.begin(), col_removals.end()), col_removals.end());
+    // New index of an old index, std::nullopt if removed
+    auto remap = [](const std::size_t index, const std::vector<std::size_t>& inserts,
+                    const std::vector<std::size_t>& removals) -> std::optional<std::size_t> {
+        const auto removed = std::lower_bound(removals.begin(), removals.end(), index);
+        if ((removed != removals.end()) && (*removed == index)) return std::nullopt;
+        const auto inserted = std::upper_bound(inserts.begin(), inserts.end(), index);
+        return index + std::size_t(inserted - inserts.begin()) - std::size_t(removed - removals.begin());
+    };
+
+    std::vector<std::size_t> removed_ids;
+    for (auto& [id, actor] : m_actors)
+    {
+        const std::optional<std::size_t> row{remap(actor.GetPosition().y, row_inserts, row_removals)};
+        const std::optional<std::size_t> col{remap(actor.GetPosition().x, col_inserts, col_removals)};
+        if (row && col)
+            actor.SetPosition(Position<std::size_t>(*col, *row));
+        else
+            removed_ids.push_back(id);
+    }
+    for (const std::size_t id : removed_ids)
+    {
+        m_index.free_slots.push_back(m_index.slot_of.at(id));
+        m_index.slot_of.erase(id);
+        m_actors.erase(id);
+    }
+    m_index.n_rows = 0U;  // Relink all the actors on the next query
+}
+
+/// @brief Index of the cell of a position (wrapped on infinite grids)
+/// @throw std::out_of_range If the position is outside of a finite grid
+inline std::size_t Grid::m_ActorCell(const Position<std::size_t>& position) const
+{
+    std::size_t row{position.y};
+    std::size_t col{position.x};
+    if (row >= m_rows || col >= m_cols)
+    {
+        if (m_infinite && (m_rows > 0U) && (m_cols > 0U))
+        {
+            row %= m_rows;
+            col %= m_cols;
+        }
+        else
+        {
+            throw std::out_of_range("Grid::m_ActorCell(): Position is out of range");
+        }
+    }
+    return row * m_cols + col;
+}
+
+/// @brief Push a slot at the head of the list of a cell
+inline void Grid::m_Link(const std::uint32_t slot, const std::size_t cell) const
+{
+    ActorSlot& actor_slot = m_index.slots[slot];
+    actor_slot.cell = cell;
+    actor_slot.prev = kNoSlot;
+    actor_slot.next = m_index.cell_head[cell];
+    if (actor_slot.next != kNoSlot) m_index.slots[actor_slot.next].prev = slot;
+    m_index.cell_head[cell] = slot;
+}
+
+/// @brief Remove a slot from the list of its cell
+inline void Grid::m_Unlink(const std::uint32_t slot) const
+{
+    const ActorSlot& actor_slot = m_index.slots[slot];
+    if (actor_slot.prev != kNoSlot)
+        m_index.slots[actor_slot.prev].next = actor_slot.next;
+    else
+        m_index.cell_head[actor_slot.cell] = actor_slot.next;
+    if (actor_slot.next != kNoSlot) m_index.slots[actor_slot.next].prev = actor_slot.prev;
+}
+
 /// @brief Add a tile definition (linking a tile type to a character)
 /// @param tiletype Tile type to define (type: TileType)
 /// @param character Character to link
-bool Grid::AddTileTypeDefinition(TileType tiletype, char character)
+/// @return false if the tile type is undefined or already defined, or if the character is already linked
+inline bool Grid::AddTileTypeDefinition(TileType tiletype, char character)
+{
+    if ((tiletype == TileType::kTileType_Undefined) ||
+        (m_tile_of_char[static_cast<unsigned char>(character)] != TileType::kTileType_Undefined))
+        return false;
+    if (!m_tiles.insert(std::make_pair(tiletype, character)).second) return false;
+    m_tile_of_char[static_cast<unsigned char>(character)] = tiletype;
+    m_plane.stale = true;
+    return true;
+}
+
+/// @brief Enable or disable the materialized tile plane
+/// @details While enabled, CountTiles is O(1) and TilePositions is output-sized. Writes through operator() are
+///          applied to the plane on the next query; bulk edits (Fill, Replace, SwapData, structural edits, ...) rebuild
+///          it. Only raw writes (data(), operator[], views) are not seen: call RebuildTilePlane() after them
+inline void Grid::MaterializeTiles(const bool enable)
+{
+    m_plane = TilePlane{};
+    m_plane.enabled = enable;
+}
+
+/// @brief Force a full rebuild of the tile plane on the next query
+inline void Grid::RebuildTilePlane()
 {
+    m_plane.stale = true;
+}
+
+/// @brief Number of cells of a tile type: O(1) with a tile plane, a vectorized scan otherwise
+inline std::size_t Grid::CountTiles(const TileType tiletype) const
+{
+    if (m_plane.enabled)
+    {
+        m_SyncTilePlane();
+        return m_plane.positions[static_cast<std::size_t>(tiletype)].size();
+    }
     if (tiletype != TileType::kTileType_Undefined)
     {
-        std::vector<char> vals;
-        for (auto kv : m_tiles)
+        const auto it = m_tiles.find(tiletype);
+        return (it == m_tiles.end()) ? 0U : CountElements(it->second);
+    }
+    std::size_t defined{0U};
+    for (const auto& [type, character] : m_tiles)
+        defined += CountElements(character);
+    return m_rows * m_cols - defined;
+}
+
+/// @brief Index the cells of some values, so that CountInRectangle answers in O(1) to O(log rows x log cols) for them
+/// @details Writes through operator() are seen by the index and bulk edits (Fill, Replace, SwapData, structural
+///          edits, ...) rebuild it. Only raw writes (data(), operator[], views) are not seen: call RebuildValueIndex()
+/// @param values Values to index (at most 254), an empty vector drops the index
+/// @throw std::length_error If there are too many values
+inline void Grid::IndexValues(const std::vector<char>& values)
+{
+    if (values.size() >= kNoPlane) throw std::length_error("Grid::IndexValues(values): Too many values");
+    m_counts = CountPlanes();
+    if (values.empty()) return;
+    for (const char value : values)
+    {
+        if (m_counts.plane_of[static_cast<unsigned char>(value)] != kNoPlane) continue;
+        m_counts.plane_of[static_cast<unsigned char>(value)] = static_cast<std::uint8_t>(m_counts.values.size());
+        m_counts.values.push_back(value);
+    }
+    m_counts.enabled = true;
+}
+
+/// @brief Rebuild the value index on the next query (needed after writes that bypass operator())
+inline void Grid::RebuildValueIndex()
+{
+    m_counts.stale = true;
+}
+
+/// @brief Number of cells equal to a value in a rectangle (bounds included, clamped to the grid). If the value is
+///        indexed: O(1) when no write happened since the planes were built, O(log rows x log cols) otherwise, plus
+///        O(log rows x log cols) per write since the previous query. A scan of the rectangle otherwise
+inline std::size_t Grid::CountInRectangle(const char value,
+                                          const std::size_t first_row,
+                                          const std::size_t first_col,
+                                          const std::size_t last_row,
+                                          const std::size_t last_col) const
+{
+    if ((m_rows == 0U) || (m_cols == 0U)) return 0U;
+    const std::size_t end_row{std::min(last_row, m_rows - 1U) + 1U};
+    const std::size_t end_col{std::min(last_col, m_cols - 1U) + 1U};
+    if ((first_row >= end_row) || (first_col >= end_col)) return 0U;
+
+    const std::uint8_t plane{m_counts.plane_of[static_cast<unsigned char>(value)]};
+    if (!m_counts.enabled || (plane == kNoPlane))
+    {
+        std::size_t count{0U};
+        for (std::size_t row{first_row}; row < end_row; ++row)
+        {
+            const char* cells = m_data + m_Index(row, 0U);
+            count += static_cast<std::size_t>(std::count(cells + first_col, cells + end_col, value));
+        }
+        return count;
+    }
+
+    m_SyncCountPlanes();
+    const std::vector<std::uint32_t>& prefix = m_counts.prefix[plane];
+    const std::size_t stride{m_cols + 1U};
+    std::ptrdiff_t count{std::ptrdiff_t(prefix[end_row * stride + end_col]) -
+                         std::ptrdiff_t(prefix[first_row * stride + end_col]) -
+                         std::ptrdiff_t(prefix[end_row * stride + first_col]) +
+                         std::ptrdiff_t(prefix[first_row * stride + first_col])};
+    if (m_counts.n_folded > 0U)
+    {
+        count += m_FoldedCount(plane, end_row, end_col) - m_FoldedCount(plane, first_row, end_col) -
+                 m_FoldedCount(plane, end_row, first_col) + m_FoldedCount(plane, first_row, first_col);
+    }
+    return static_cast<std::size_t>(count);
+}
+
+/// @brief Maintain the Zobrist hash of the cells incrementally, so that Hash() costs O(writes since the last call)
+/// @details Writes through operator() are seen by the hash and bulk edits (Fill, Replace, SwapData, structural
+///          edits, ...) rehash all the cells. Only raw writes (data(), operator[], views) are not seen: call
+///          RehashCells() after them
+inline void Grid::EnableHashing(const bool enable)
+{
+    m_hash = CellHash();
+    m_hash.enabled = enable;
+}
+
+/// @brief Rehash all the cells on the next call of Hash() (needed after writes that bypass operator())
+inline void Grid::RehashCells()
+{
+    m_hash.stale = true;
+}
+
+/// @brief 64-bit Zobrist hash of the cells and of the dimensions of the grid (actors are not included)
+/// @details Equal grids have equal hashes, different grids collide with probability ~2^-64. Without EnableHashing()
+///          every call hashes all the cells
+inline std::uint64_t Grid::Hash() const
+{
+    // The dimensions are keyed as two cells past the end of the grid
+    const std::size_t n_cells{m_rows * m_cols};
+    const std::uint64_t shape{m_ZobristKey(n_cells, '\0') ^ m_ZobristKey(n_cells + 1U + m_cols, '\0')};
+    if (!m_hash.enabled) return m_FullHash() ^ shape;
+
+    CellHash& hash = m_hash;
+    if (hash.stale || (hash.n_rows != m_rows) || (hash.n_cols != m_cols) ||
+        (hash.modifications != m_modifications))
+    {
+        hash.stale = false;
+        hash.n_rows = m_rows;
+        hash.n_cols = m_cols;
+        hash.modifications = m_modifications;
+        hash.value = m_FullHash();
+        hash.dirty.assign(m_rows * m_cols, 0U);
+        hash.pending.clear();
+        return hash.value ^ shape;
+    }
+    for (const auto& [cell, old_value] : hash.pending)
+    {
+        hash.value ^= m_ZobristKey(cell, old_value) ^ m_ZobristKey(cell, m_data[m_Index(cell / m_cols, cell % m_cols)]);
+        hash.dirty[cell] = 0U;
+    }
+    hash.pending.clear();
+    return hash.value ^ shape;
+}
+
+/// @brief Key of a value in a cell: a mix (splitmix64 finalizer) of both instead of a (cells x 256) random table
+inline std::uint64_t Grid::m_ZobristKey(const std::size_t cell, const char value)
+{
+    std::uint64_t key{(std::uint64_t(cell) << 8U) + static_cast<unsigned char>(value) + 0x9e3779b97f4a7c15ULL};
+    key = (key ^ (key >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+    key = (key ^ (key >> 27U)) * 0x94d049bb133111ebULL;
+    return key ^ (key >> 31U);
+}
+
+/// @brief XOR of the keys of all the cells
+inline std::uint64_t Grid::m_FullHash() const
+{
+    std::uint64_t hash{0U};
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        const char* cells = m_data + m_Index(row, 0U);
+        for (std::size_t col{0U}; col < m_cols; ++col)
+            hash ^= m_ZobristKey(row * m_cols + col, cells[col]);
+    }
+    return hash;
+}
+
+inline std::array<std::uint8_t, 256U> Grid::m_NoPlanes()
+{
+    std::array<std::uint8_t, 256U> planes;
+    planes.fill(kNoPlane);
+    return planes;
+}
+
+/// @brief Bring the count planes up to date: the pending writes are folded into the Fenwick trees, unless the grid
+///        was resized or bulk edited, a rebuild was requested, or more writes than a sixteenth of the cells (at least
+///        64) have been folded since the last rebuild, in which case the planes are rebuilt
+inline void Grid::m_SyncCountPlanes() const
+{
+    CountPlanes& counts = m_counts;
+    const std::size_t limit{std::max<std::size_t>(64U, m_rows * m_cols / 16U)};
+    if (!counts.stale && (counts.n_rows == m_rows) && (counts.n_cols == m_cols) &&
+        (counts.modifications == m_modifications) && (counts.n_folded + counts.pending.size() <= limit))
+    {
+        const std::size_t stride{m_cols + 1U};
+        for (const auto& [cell, old_value] : counts.pending)
         {
-            vals.push_back(kv.second);
+            counts.dirty[cell] = 0U;
+            const std::size_t row{cell / m_cols};
+            const std::size_t col{cell % m_cols};
+            const std::uint8_t old_plane{counts.plane_of[static_cast<unsigned char>(old_value)]};
+            const std::uint8_t new_plane{counts.plane_of[static_cast<unsigned char>(m_data[m_Index(row, col)])]};
+            if (old_plane == new_plane) continue;
+            for (const auto [plane, delta] : {std::make_pair(old_plane, -1), std::make_pair(new_plane, 1)})
+            {
+                if (plane == kNoPlane) continue;
+                std::vector<std::int32_t>& tree = counts.tree[plane];
+                if (tree.empty()) tree.assign((m_rows + 1U) * stride, 0);
+                for (std::size_t i{row + 1U}; i <= m_rows; i += i & (~i + 1U))
+                    for (std::size_t j{col + 1U}; j <= m_cols; j += j & (~j + 1U))
+                        tree[i * stride + j] += delta;
+            }
+            ++counts.n_folded;
         }
-        if (!std::count(vals.begin(), vals.end(), character))
+        counts.pending.clear();
+        return;
+    }
+
+    counts.stale = false;
+    counts.n_rows = m_rows;
+    counts.n_cols = m_cols;
+    counts.modifications = m_modifications;
+    counts.dirty.assign(m_rows * m_cols, 0U);
+    counts.pending.clear();
+    counts.tree.assign(counts.values.size(), {});
+    counts.n_folded = 0U;
+    const std::size_t stride{m_cols + 1U};
+    counts.prefix.resize(counts.values.size());
+    for (std::vector<std::uint32_t>& prefix : counts.prefix)
+        prefix.assign((m_rows + 1U) * stride, 0U);
+    std::vector<std::uint32_t> row_counts(counts.values.size());
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        const char* cells = m_data + m_Index(row, 0U);
+        std::fill(row_counts.begin(), row_counts.end(), 0U);
+        for (std::size_t col{0U}; col < m_cols; ++col)
         {
-            m_tiles.insert(std::make_pair(tiletype, character));
-            return true;
+            const std::uint8_t plane{counts.plane_of[static_cast<unsigned char>(cells[col])]};
+            if (plane != kNoPlane) ++row_counts[plane];
+            for (std::size_t p{0U}; p < counts.prefix.size(); ++p)
+            {
+                std::uint32_t* prefix = counts.prefix[p].data();
+                prefix[(row + 1U) * stride + col + 1U] = prefix[row * stride + col + 1U] + row_counts[p];
+            }
         }
     }
-    return false;
 }
 
-/// @brief Redefinition of operator() to take into account infinite grids
-char& Grid::operator()(std::size_t row, std::size_t col)
+/// @brief Count delta of the folded writes in the cells above row and left of col (Fenwick tree prefix query)
+inline std::ptrdiff_t Grid::m_FoldedCount(const std::uint8_t plane, const std::size_t row, const std::size_t col) const
 {
-    if (row >= m_rows || col >= m_cols)
+    const std::vector<std::int32_t>& tree = m_counts.tree[plane];
+    if (tree.empty()) return 0;
+    const std::size_t stride{m_cols + 1U};
+    std::ptrdiff_t count{0};
+    for (std::size_t i{row}; i > 0U; i &= i - 1U)
+        for (std::size_t j{col}; j > 0U; j &= j - 1U)
+            count += tree[i * stride + j];
+    return count;
+}
+
+/// @brief Positions (x = column, y = row) of the cells of a tile type, in no specific order
+/// @throw std::logic_error If the tile plane is not materialized
+inline const std::vector<Position<std::size_t>>& Grid::TilePositions(const TileType tiletype) const
+{
+    if (!m_plane.enabled) throw std::logic_error("Grid::TilePositions(): Tile plane is not materialized");
+    m_SyncTilePlane();
+    return m_plane.positions[static_cast<std::size_t>(tiletype)];
+}
+
+inline std::array<TileType, 256U> Grid::m_UndefinedTiles()
+{
+    std::array<TileType, 256U> tiles;
+    tiles.fill(TileType::kTileType_Undefined);
+    return tiles;
+}
+
+/// @brief Apply the pending writes to the tile plane (or rebuild it)
+inline void Grid::m_SyncTilePlane() const
+{
+    TilePlane& plane = m_plane;
+    if (plane.stale || (plane.n_rows != m_rows) || (plane.n_cols != m_cols) ||
+        (plane.modifications != m_modifications))
     {
-        if (m_infinite)
+        plane.stale = false;
+        plane.n_rows = m_rows;
+        plane.n_cols = m_cols;
+        plane.modifications = m_modifications;
+        plane.types.resize(m_rows * m_cols);
+        plane.slot.resize(m_rows * m_cols);
+        plane.dirty.assign(m_rows * m_cols, 0U);
+        plane.pending.clear();
+        for (auto& positions : plane.positions)
+            positions.clear();
+        for (std::size_t row{0U}; row < m_rows; ++row)
         {
-            return m_data[row % m_rows][col % m_cols];
+            const char* values = m_data + m_Index(row, 0U);
+            for (std::size_t col{0U}; col < m_cols; ++col)
+            {
+                const std::size_t cell{row * m_cols + col};
+                const auto type = static_cast<std::size_t>(GetTileType(values[col]));
+                plane.types[cell] = static_cast<std::uint8_t>(type);
+                plane.slot[cell] = static_cast<std::uint32_t>(plane.positions[type].size());
+                plane.positions[type].emplace_back(col, row);
+            }
         }
-        else
+        return;
+    }
+    for (const std::uint32_t cell : plane.pending)
+    {
+        plane.dirty[cell] = 0U;
+        const std::size_t row{cell / m_cols};
+        const std::size_t col{cell % m_cols};
+        const auto type = static_cast<std::size_t>(GetTileType(m_data[m_Index(row, col)]));
+        const std::size_t old_type{plane.types[cell]};
+        if (type == old_type) continue;
+        // Swap-remove from the old list, append to the new one
+        auto& old_positions = plane.positions[old_type];
+        const Position<std::size_t> moved = old_positions.back();
+        old_positions[plane.slot[cell]] = moved;
+        plane.slot[moved.y * m_cols + moved.x] = plane.slot[cell];
+        old_positions.pop_back();
+        plane.types[cell] = static_cast<std::uint8_t>(type);
+        plane.slot[cell] = static_cast<std::uint32_t>(plane.positions[type].size());
+        plane.positions[type].emplace_back(col, row);
+    }
+    plane.pending.clear();
+}
+
+/// @brief Enable or disable change tracking
+/// @details While enabled, every write through the non-const operator() is recorded; CommitChanges() then closes a
+///          step and keeps the cells whose value differs from the one they had at the previous commit. Writes that
+///          bypass operator() (data(), Fill, Replace, InsertRow, ...) are not seen: call MarkAllActive() after them.
+///          Enabling the tracking marks all cells as active
+inline void Grid::TrackChanges(const bool enable)
+{
+    m_tracking = enable;
+    m_commits = 0U;
+    m_ResetTracking();
+    if (!enable)
+    {
+        m_logged = {};
+        m_active_mark = {};
+        m_all_active = false;
+    }
+}
+
+/// @brief Forget the current change set and consider all cells active until the next commit
+inline void Grid::MarkAllActive()
+{
+    if (m_tracking) m_ResetTracking();
+}
+
+/// @brief Close a step: keep the cells written since the last commit whose value actually changed
+/// @return Number of changed cells (all cells if the grid has been resized)
+inline std::size_t Grid::CommitChanges()
+{
+    if (!m_tracking) return 0U;
+    ++m_commits;
+    if ((m_tracked_rows != m_rows) || (m_tracked_cols != m_cols))
+    {
+        m_ResetTracking();
+        return m_rows * m_cols;
+    }
+    m_changed.clear();
+    for (const auto& [cell, old_value] : m_write_log)
+    {
+        m_logged[cell] = 0U;
+        const std::size_t row{cell / m_cols};
+        const std::size_t col{cell % m_cols};
+        if (m_data[m_Index(row, col)] != old_value) m_changed.emplace_back(row, col);
+    }
+    m_write_log.clear();
+    m_all_active = false;
+    return m_changed.size();
+}
+
+/// @brief Cells within radius (Chebyshev distance) of a cell changed before the last commit or since then, i.e. the
+///        only cells whose neighbourhood can differ from the previous step. Each cell is listed once
+/// @param radius Neighbourhood radius of the simulation (1 for 4/8 neighbours)
+/// @param wrap Wrap around the borders (always on for infinite grids)
+/// @return Active cells, all cells if AllCellsActive()
+inline std::vector<std::pair<std::size_t, std::size_t>> Grid::ActiveCells(const std::size_t radius,
+                                                                          const bool wrap) const
+{
+    std::vector<std::pair<std::size_t, std::size_t>> active;
+    if (m_all_active || (m_tracked_rows != m_rows) || (m_tracked_cols != m_cols))
+    {
+        active.reserve(m_rows * m_cols);
+        for (std::size_t row{0U}; row < m_rows; ++row)
+            for (std::size_t col{0U}; col < m_cols; ++col)
+                active.emplace_back(row, col);
+        return active;
+    }
+    const bool wraps{wrap || m_infinite};
+    const long r{static_cast<long>(radius)};
+    const long n_rows{static_cast<long>(m_rows)};
+    const long n_cols{static_cast<long>(m_cols)};
+    auto add_neighbourhood = [&](const std::size_t changed_row, const std::size_t changed_col) {
+        for (long dr{-r}; dr <= r; ++dr)
         {
-            throw std::out_of_range("Matrix<T>::operator(): Index is out of range");
+            for (long dc{-r}; dc <= r; ++dc)
+            {
+                long row{static_cast<long>(changed_row) + dr};
+                long col{static_cast<long>(changed_col) + dc};
+                if (wraps)
+                {
+                    row = ((row % n_rows) + n_rows) % n_rows;
+                    col = ((col % n_cols) + n_cols) % n_cols;
+                }
+                else if ((row < 0) || (col < 0) || (row >= n_rows) || (col >= n_cols))
+                {
+                    continue;
+                }
+                const std::size_t cell{static_cast<std::size_t>(row * n_cols + col)};
+                if (m_active_mark[cell] == 0U)
+                {
+                    m_active_mark[cell] = 1U;
+                    active.emplace_back(static_cast<std::size_t>(row), static_cast<std::size_t>(col));
+                }
+            }
         }
+    };
+    for (const auto& [row, col] : m_changed)
+        add_neighbourhood(row, col);
+    // Writes not committed yet
+    for (const auto& [cell, old_value] : m_write_log)
+    {
+        const std::size_t row{cell / m_cols};
+        const std::size_t col{cell % m_cols};
+        if (m_data[m_Index(row, col)] != old_value) add_neighbourhood(row, col);
+    }
+    for (const auto& [row, col] : active)
+        m_active_mark[row * m_cols + col] = 0U;
+    return active;
+}
+
+/// @brief Drop the logged writes and the change set, all cells become active
+inline void Grid::m_ResetTracking()
+{
+    m_tracked_rows = m_rows;
+    m_tracked_cols = m_cols;
+    m_write_log.clear();
+    m_changed.clear();
+    m_all_active = true;
+    if (m_tracking)
+    {
+        m_logged.assign(m_rows * m_cols, 0U);
+        m_active_mark.assign(m_rows * m_cols, 0U);
     }
-    return m_data[row][col];
+}
+
+/// @brief Log a write to a cell in the change tracking and the grid indexes that are enabled
+inline void Grid::m_MarkWrite(const std::size_t row, const std::size_t col)
+{
+    if (m_tracking) m_LogWrite(row, col);
+    if (m_plane.enabled) m_MarkTileDirty(row, col);
+    if (m_counts.enabled) m_MarkCountDirty(row, col);
+    if (m_hash.enabled) m_MarkHashDirty(row, col);
 }
 
 /// @brief Redefinition of operator() to take into account infinite grids
-char const& Grid::operator()(std::size_t row, std::size_t col) const
+/// @return Reference to the cell: reading it costs nothing more than the const operator(), assigning it logs the write
+///         (change tracking, tile plane, value counts, hash)
+inline Grid::CellRef Grid::operator()(std::size_t row, std::size_t col)
 {
-    if (row >= m_rows || col >= m_cols)
+    if (m_infinite)
     {
-        if (m_infinite)
-        {
-            return m_data[row % m_rows][col % m_cols];
-        }
-        else
+        if ((row >= m_rows) || (col >= m_cols))
         {
-            throw std::out_of_range("Matrix<T>::operator(): Index is out of range");
+            row %= m_rows;
+            col %= m_cols;
         }
     }
-    return m_data[row][col];
+    else
+    {
+        DefaultBoundsCheck::Check((row < m_rows) && (col < m_cols), "Matrix<T>::operator(): Index is out of range");
+    }
+    return CellRef(*this, row, col, m_data + m_Index(row, col));
+}
+
+/// @brief Redefinition of operator() to take into account infinite grids
+inline char const& Grid::operator()(std::size_t row, std::size_t col) const
+{
+    if (m_infinite)
+    {
+        if ((row >= m_rows) || (col >= m_cols)) return m_data[m_Index(row % m_rows, col % m_cols)];
+    }
+    else
+    {
+        DefaultBoundsCheck::Check((row < m_rows) && (col < m_cols), "Matrix<T>::operator(): Index is out of range");
+    }
+    return m_data[m_Index(row, col)];
 }
 
 }  // namespace commonlib
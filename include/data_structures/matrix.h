@@ -4,47 +4,166 @@
 #ifndef DATA_STRUCTURES_MATRIX_H
 #define DATA_STRUCTURES_MATRIX_H
 
+#include <algorithm>
 #include <charconv>
+#include <cstdint>
+#include <cstring>
 #include <fstream>
 #include <iostream>
-#include <sstream>
+#include <iterator>
+#include <memory>
+#include <optional>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#ifdef TEST_BUILD
+#include <data_structures/fixed_matrix.h>
+#include <data_structures/matrix_view.h>
+#include <io/delimited_scanner.h>
+#include <io/mapped_file.h>
+#include <io/snapshot.h>
+#include <utils/bounds_check.h>
+#include <utils/simd.h>
+#include <utils/thread_pool.h>
+#else
+#include <commonlib/include/data_structures/fixed_matrix.h>
+#include <commonlib/include/data_structures/matrix_view.h>
+#include <commonlib/include/io/delimited_scanner.h>
+#include <commonlib/include/io/mapped_file.h>
+#include <commonlib/include/io/snapshot.h>
+#include <commonlib/include/utils/bounds_check.h>
+#include <commonlib/include/utils/simd.h>
+#include <commonlib/include/utils/thread_pool.h>
+#endif
+
 namespace commonlib
 {
+/// @class MatrixEdits
+/// @brief Batch of structural edits (row/column inserts and removals) applied by Matrix::ApplyEdits in a single pass
+/// @details All indices refer to the matrix before the batch: an insert at index i goes before the original row
+///          (column) i, whether it is removed or not, or at the end if i is the number of rows (columns). Inserts at
+///          the same index keep their order, removing a row (column) twice removes it once. Inserted rows must have
+///          the final number of columns and inserted columns the final number of rows: where an inserted row crosses
+///          an inserted column, the row value is kept
+/// @tparam T Type of data stored
+template <typename T>
+class MatrixEdits
+{
+  public:
+    inline MatrixEdits& InsertRow(const std::size_t index, std::vector<T> new_row)
+    {
+        m_row_inserts.emplace_back(index, std::move(new_row));
+        return *this;
+    }
+    inline MatrixEdits& InsertColumn(const std::size_t index, std::vector<T> new_column)
+    {
+        m_col_inserts.emplace_back(index, std::move(new_column));
+        return *this;
+    }
+    inline MatrixEdits& RemoveRow(const std::size_t index)
+    {
+        m_row_removals.push_back(index);
+        return *this;
+    }
+    inline MatrixEdits& RemoveColumn(const std::size_t index)
+    {
+        m_col_removals.push_back(index);
+        return *this;
+    }
+    inline bool Empty() const
+    {
+        return m_row_inserts.empty() && m_col_inserts.empty() && m_row_removals.empty() && m_col_removals.empty();
+    }
+    inline void Clear() { *this = MatrixEdits(); }
+
+    inline const std::vector<std::pair<std::size_t, std::vector<T>>>& RowInserts() const { return m_row_inserts; }
+    inline const std::vector<std::pair<std::size_t, std::vector<T>>>& ColumnInserts() const { return m_col_inserts; }
+    inline const std::vector<std::size_t>& RowRemovals() const { return m_row_removals; }
+    inline const std::vector<std::size_t>& ColumnRemovals() const { return m_col_removals; }
+
+  private:
+    std::vector<std::pair<std::size_t, std::vector<T>>> m_row_inserts;
+    std::vector<std::pair<std::size_t, std::vector<T>>> m_col_inserts;
+    std::vector<std::size_t> m_row_removals;
+    std::vector<std::size_t> m_col_removals;
+};
+
 /// @class Matrix
 /// @brief 2D generic matrix template
+/// @details Elements are stored row-major in a single contiguous buffer. Element (row, col) lives at
+///          data()[row * RowStride() + col * ColStride()]
 /// @tparam T Type of data stored
-template <typename T>
+/// @tparam BoundsCheck Bounds-check policy of operator() (BoundsChecked, BoundsAsserted or BoundsUnchecked, see
+///         utils/bounds_check.h), COMMONLIB_BOUNDS_CHECK selects the default
+template <typename T, typename BoundsCheck = DefaultBoundsCheck>
 class Matrix
 {
   public:
+    using value_type = T;
+    using matrix_type = Matrix;  ///< Matrix base of derived classes, with its bounds-check policy
+
     // Constructors
     Matrix(const std::size_t n_rows, const std::size_t n_cols);
     Matrix(const std::size_t n_rows, const std::size_t n_cols, const T init_value);
     Matrix(const std::vector<std::vector<T>> matrix);
     Matrix(std::ifstream& fp, const std::size_t n_rows, const std::size_t n_cols);
     Matrix(std::ifstream& fp, const char row_sep = ',');
+    Matrix(const MappedFile& file, const std::size_t n_rows, const std::size_t n_cols);
+    Matrix(const MappedFile& file, const char row_sep = ',');
+    Matrix(std::ifstream& fp, const char row_sep, ThreadPool& pool);
+    Matrix(const MappedFile& file, const char row_sep, ThreadPool& pool);
+    Matrix(const Matrix& other);
+    Matrix(Matrix&& other) noexcept;
+    Matrix& operator=(const Matrix& other);
+    Matrix& operator=(Matrix&& other) noexcept;
 
     // Setters / Inserters
-    void InsertRow(const std::size_t index, const std::vector<T> new_row = {});
-    void InsertColumn(const std::size_t index, const std::vector<T> new_col = {});
-    void RemoveRow(const std::size_t index);     // TODO
-    void RemoveColumn(const std::size_t index);  // TODO
+    void InsertRow(const std::size_t index, const std::vector<T>& new_row = {});
+    void InsertRow(const std::size_t index, RowView<const T> new_row);
+    void InsertColumn(const std::size_t index, const std::vector<T>& new_col = {});
+    void InsertColumn(const std::size_t index, ColumnView<const T> new_col);
+    void RemoveRow(const std::size_t index);
+    void RemoveColumn(const std::size_t index);
+    void ApplyEdits(const MatrixEdits<T>& edits);
+    void SwapData(Matrix& other);
 
-    // Getters
-    inline std::vector<std::vector<T>> Data() const { return m_data; }
-    inline std::vector<T> Row(const std::size_t row) { return m_data[row]; };
-    inline std::vector<T> Column(const std::size_t col)
+    // Getters (views are non-owning: they are invalidated by any operation changing the matrix size)
+    inline MatrixView<const T> Data() const { return View(); }
+    inline MatrixView<T> View() { return MatrixView<T>(m_data, m_rows, m_cols, m_row_stride); }
+    inline MatrixView<const T> View() const { return MatrixView<const T>(m_data, m_rows, m_cols, m_row_stride); }
+    inline MatrixView<T> SubView(const std::size_t row,
+                                 const std::size_t col,
+                                 const std::size_t n_rows,
+                                 const std::size_t n_cols)
     {
-        std::vector<T> out;
-        for (const auto& row : m_data)
-            out.push_back(row[col]);
-        return out;
+        return View().SubView(row, col, n_rows, n_cols);
     }
-    inline std::size_t NRows() const { return m_data.size(); }
-    inline std::size_t NCols() const { return m_data[0].size(); }
+    inline MatrixView<const T> SubView(const std::size_t row,
+                                       const std::size_t col,
+                                       const std::size_t n_rows,
+                                       const std::size_t n_cols) const
+    {
+        return View().SubView(row, col, n_rows, n_cols);
+    }
+    inline RowView<T> Row(const std::size_t row) { return View().Row(row); }
+    inline RowView<const T> Row(const std::size_t row) const { return View().Row(row); }
+    inline ColumnView<T> Column(const std::size_t col) { return View().Column(col); }
+    inline ColumnView<const T> Column(const std::size_t col) const { return View().Column(col); }
+    inline std::size_t NRows() const { return m_rows; }
+    inline std::size_t NCols() const { return m_cols; }
+
+    // Raw storage access (row-major, element (r, c) is at data()[r * RowStride() + c * ColStride()])
+    inline T* data() { return m_data; }
+    inline const T* data() const { return m_data; }
+    inline std::size_t RowStride() const { return m_row_stride; }
+    inline constexpr std::size_t ColStride() const { return 1U; }
+    inline bool IsContiguous() const { return m_row_stride == m_cols; }
+    /// @brief Counter bumped by every operation replacing the elements or the storage in bulk (Fill, Replace, SwapData,
+    ///        structural edits, ...), not by single element writes: caches derived from the elements compare it
+    inline std::uint64_t Modifications() const { return m_modifications; }
 
     // Utils / Properties
     void Print(char col_sep = ' ', char row_sep = '\n');
@@ -53,165 +172,293 @@ class Matrix
 
     // Advanced operations
     void PropagateHorizontally(const std::size_t times);
+    void PropagateVertically(const std::size_t times);
+    void Tile(const std::size_t n_row_copies, const std::size_t n_col_copies);
+    inline TiledView<T> Tiled(const std::size_t n_row_copies, const std::size_t n_col_copies) const
+    {
+        return TiledView<T>(View(), m_rows * n_row_copies, m_cols * n_col_copies);
+    }
     Matrix CutWindow(const std::size_t row,
                      const std::size_t col,
                      const std::size_t window_width,
                      const T fill_value = {});
-    const std::size_t CountElements(const T searched_element);
+    template <std::size_t W>
+    FixedMatrix<T, W, W, BoundsCheck> CutWindow(const std::size_t row,
+                                                const std::size_t col,
+                                                const T fill_value = {}) const;
+    template <typename F>
+    void ForEachWindow(const std::size_t window_width,
+                       F&& fn,
+                       const T fill_value = {},
+                       ThreadPool* pool = nullptr) const;
+
+    // Bulk scans (vectorized for arithmetic types, see utils/simd.h)
+    std::size_t CountElements(const T searched_element) const;
+    std::optional<std::pair<std::size_t, std::size_t>> Find(const T searched_element) const;
+    std::vector<std::pair<std::size_t, std::size_t>> FindAll(const T searched_element) const;
+    std::size_t Replace(const T old_value, const T new_value);
+    void Fill(const T value);
+
+    // Binary snapshots (trivially copyable T only, format in io/snapshot.h)
+    void SaveSnapshot(std::ostream& out) const;
+    void SaveSnapshot(const std::string& path) const;
+    static Matrix LoadSnapshot(std::shared_ptr<MappedFile> file, const bool verify_checksum = true);
 
-    // Operators
+    // Operators (operator() checks the indices according to BoundsCheck, operator[] never does: matrix[row][col])
     T& operator()(const std::size_t row, const std::size_t col);
     T const& operator()(const std::size_t row, const std::size_t col) const;
-    inline bool operator==(T const& other) { return m_data == other.m_data; }
-    inline bool operator!=(T const& other) { return m_data != other.m_data; }
+    inline T* operator[](const std::size_t row) { return m_data + row * m_row_stride; }
+    inline const T* operator[](const std::size_t row) const { return m_data + row * m_row_stride; }
 
   protected:
-    std::vector<std::vector<T>> m_data;
-    std::size_t m_rows;
-    std::size_t m_cols;
+    Matrix() = default;
 
-    void m_UnpackFlatMatrix(std::vector<T> flat_matrix);
-    inline void m_UpdateSize()
+    std::unique_ptr<T[]> m_buffer;  ///< Owned storage
+    std::size_t m_capacity{0U};     ///< Number of elements allocated in m_buffer
+    T* m_data{nullptr};             ///< First element of the matrix
+    std::size_t m_rows{0U};
+    std::size_t m_cols{0U};
+    std::size_t m_row_stride{0U};  ///< Distance (in elements) between the first elements of two consecutive rows
+    std::shared_ptr<void> m_owner;  ///< Keeps alive external storage borrowed by m_data (empty when m_data is owned)
+    std::uint64_t m_modifications{0U};  ///< See Modifications()
+
+    void m_ParseText(const char* begin, const char* end, const char row_sep, ThreadPool* pool = nullptr);
+    std::size_t m_ParseRows(const char* begin, const char* end, const char row_sep, const std::size_t first_row);
+    void m_ParseFlat(const char* begin, const char* end, const std::size_t n_rows, const std::size_t n_cols);
+    void m_Allocate(const std::size_t n_rows, const std::size_t n_cols, const std::size_t capacity = 0U);
+    void m_Reserve(const std::size_t capacity);
+    inline std::size_t m_Index(const std::size_t row, const std::size_t col) const
+    {
+        return row * m_row_stride + col;
+    }
+    inline bool m_Aliases(const T* ptr) const
+    {
+        return (ptr >= m_data) && (ptr < m_data + std::max(m_capacity, m_rows * m_row_stride));
+    }
+    static std::string m_ReadAll(std::ifstream& fp);
+    static const char* m_LineEnd(const char* begin, const char* end);
+    /// @brief Call fn(span, size, offset) on the storage as one span if contiguous, row by row otherwise
+    template <typename F>
+    void m_ForEachSpan(F&& fn)
+    {
+        if (IsContiguous())
+        {
+            fn(m_data, m_rows * m_cols, std::size_t{0U});
+            return;
+        }
+        for (std::size_t row{0U}; row < m_rows; ++row)
+            fn(m_data + m_Index(row, 0U), m_cols, m_Index(row, 0U));
+    }
+    template <typename F>
+    void m_ForEachSpan(F&& fn) const
     {
-        m_rows = m_data.size();
-        m_cols = m_data[0].size();
+        const_cast<Matrix*>(this)->m_ForEachSpan(
+            [&fn](const T* span, const std::size_t size, const std::size_t offset) { fn(span, size, offset); });
     }
+    static std::size_t m_CountRows(const char* begin, const char* end);
+    template <typename F>
+    void m_WindowRows(const std::size_t first_row,
+                      const std::size_t last_row,
+                      const std::size_t window_width,
+                      F& fn,
+                      const T fill_value) const;
+    void m_WriteSnapshot(std::ostream& out, const SnapshotKind kind, const std::string& metadata) const;
+    SnapshotHeader m_BorrowSnapshot(std::shared_ptr<MappedFile> file, const bool verify_checksum);
 };
 
 /// @brief Constructor: initialize a matrix with the default value of T
 /// @param n_rows Number of rows
 /// @param n_cols Number of columns
-template <typename T>
-Matrix<T>::Matrix(const std::size_t n_rows, const std::size_t n_cols) : m_data(n_rows), m_rows(n_rows), m_cols(n_cols)
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(const std::size_t n_rows, const std::size_t n_cols)
 {
-    if ((m_rows == 0) || (m_cols == 0))
+    if ((n_rows == 0) || (n_cols == 0))
         throw std::length_error("Matrix<T>::Matrix(n_rows, n_cols): Dimensions cannot be 0");
-    for (std::size_t i{0}; i < m_rows; ++i)
-        m_data[i].resize(m_cols);
+    m_Allocate(n_rows, n_cols);
 }
 
 /// @brief Constructor: initialize a matrix with the provided value of T
 /// @param n_rows Number of rows
 /// @param n_cols Number of columns
-template <typename T>
-Matrix<T>::Matrix(const std::size_t n_rows, const std::size_t n_cols, const T init_value)
-    : m_data(n_rows), m_rows(n_rows), m_cols(n_cols)
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(const std::size_t n_rows, const std::size_t n_cols, const T init_value)
 {
-    if ((m_rows == 0) || (m_cols == 0))
+    if ((n_rows == 0) || (n_cols == 0))
         throw std::length_error("Matrix<T>::Matrix(n_rows, n_cols): Dimensions cannot be 0");
-    for (std::size_t i{0}; i < m_rows; ++i)
-        m_data[i].resize(m_cols);
-    for (auto& row : m_data)
-    {
-        for (auto& entry : row)
-        {
-            entry = init_value;
-        }
-    }
+    m_Allocate(n_rows, n_cols);
+    std::fill(m_data, m_data + m_rows * m_cols, init_value);
 }
 
 /// @brief Constructor: initialize a matrix with the default value of T
 /// @param matrix The matrix represented as a vector of vectors
 /// @throw std::length_error If the size is not coherent (not all vectors have same length)
-template <typename T>
-Matrix<T>::Matrix(const std::vector<std::vector<T>> matrix) : m_data(matrix)
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(const std::vector<std::vector<T>> matrix)
 {
-    std::size_t row_length{m_data[0].size()};
-    for (std::size_t i = 1; i < m_data.size(); ++i)
+    if (matrix.empty() || matrix[0].empty())
+        throw std::length_error("Matrix<T>::Matrix(matrix): Dimensions cannot be 0");
+    std::size_t row_length{matrix[0].size()};
+    for (std::size_t i = 1; i < matrix.size(); ++i)
     {
-        if (row_length != m_data[i].size())
+        if (row_length != matrix[i].size())
         {
             throw std::length_error(
                 "Matrix<T>::Matrix(matrix): Size not coherent, all vectors must have the same length");
         }
     }
-    m_UpdateSize();
+    m_Allocate(matrix.size(), row_length);
+    for (std::size_t i{0U}; i < m_rows; ++i)
+        std::copy(matrix[i].begin(), matrix[i].end(), m_data + m_Index(i, 0U));
 }
 
 /// @brief Constructor: initialize the matrix using its monodimensional representation
-/// @param flat_matrix Flat matrix represented as a vector of elements
+/// @param fp File stream whose first line is the flat matrix, represented as comma-separated elements
 /// @param n_rows Number of rows
 /// @param n_cols Number of columns
 /// @throw std::lenght_error If the matrix cannot be unpacked using the provided n_rows and n_cols values
-template <typename T>
-Matrix<T>::Matrix(std::ifstream& fp, const std::size_t n_rows, const std::size_t n_cols)
-    : m_rows(n_rows), m_cols(n_cols)
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(std::ifstream& fp, const std::size_t n_rows, const std::size_t n_cols)
 {
     if (!fp.is_open())
     {
         throw std::ios_base::failure("Matrix<T>::Matrix(fp, n_rows, n_cols): File not found");
     }
+    const std::string text{m_ReadAll(fp)};
+    m_ParseFlat(text.data(), text.data() + text.size(), n_rows, n_cols);
+}
 
-    std::string line;
-    getline(fp, line);
-
-    std::istringstream streamline(line);
-    std::string tok;
-    std::vector<T> flat_matrix;
-    while (getline(streamline, tok, ','))
+/// @brief Constructor: initialize the matrix using the provided file
+/// @param fp File stream to use as input for the matrix
+/// @param row_sep The separator used in the file between element (use '\0' if there is no separator)
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(std::ifstream& fp, const char row_sep)
+{
+    if (!fp.is_open())
     {
-        auto value = T{};
-        std::from_chars(tok.data(), tok.data() + tok.size(), value);
-        flat_matrix.push_back(value);
+        throw std::ios_base::failure("Matrix<T>::Matrix(fp): File not found");
     }
-    if (flat_matrix.size() != m_rows * m_cols)
-        throw std::length_error(
-            "Matrix<T>::Matrix(fp, n_rows, n_cols): Flat_matrix length is not equal to n_rows*n_cols");
+    const std::string text{m_ReadAll(fp)};
+    m_ParseText(text.data(), text.data() + text.size(), row_sep);
+}
 
-    m_UnpackFlatMatrix(flat_matrix);
+/// @brief Constructor: initialize the matrix using its monodimensional representation, parsed from a mapped file
+/// @param file Mapped file whose first line is the flat matrix, represented as comma-separated elements
+/// @param n_rows Number of rows
+/// @param n_cols Number of columns
+/// @throw std::lenght_error If the matrix cannot be unpacked using the provided n_rows and n_cols values
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(const MappedFile& file, const std::size_t n_rows, const std::size_t n_cols)
+{
+    m_ParseFlat(file.Data(), file.Data() + file.Size(), n_rows, n_cols);
 }
 
-/// @brief Constructor: initialize the matrix using the provided file
+/// @brief Constructor: initialize the matrix parsing the bytes of a mapped file (no intermediate copies)
+/// @param file Mapped file to use as input for the matrix
+/// @param row_sep The separator used in the file between element (use '\0' if there is no separator)
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(const MappedFile& file, const char row_sep)
+{
+    m_ParseText(file.Data(), file.Data() + file.Size(), row_sep);
+}
+
+/// @brief Constructor: initialize the matrix using the provided file, parsing it in parallel
 /// @param fp File stream to use as input for the matrix
 /// @param row_sep The separator used in the file between element (use '\0' if there is no separator)
-template <typename T>
-Matrix<T>::Matrix(std::ifstream& fp, const char row_sep)
+/// @param pool Thread pool parsing the chunks of the file
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(std::ifstream& fp, const char row_sep, ThreadPool& pool)
 {
     if (!fp.is_open())
     {
-        throw std::ios_base::failure("Matrix<T>::Matrix(fp): File not found");
+        throw std::ios_base::failure("Matrix<T>::Matrix(fp, row_sep, pool): File not found");
     }
+    const std::string text{m_ReadAll(fp)};
+    m_ParseText(text.data(), text.data() + text.size(), row_sep, &pool);
+}
 
-    std::string line;
-    while (getline(fp, line))
+/// @brief Constructor: initialize the matrix parsing the bytes of a mapped file in parallel
+/// @param file Mapped file to use as input for the matrix
+/// @param row_sep The separator used in the file between element (use '\0' if there is no separator)
+/// @param pool Thread pool parsing the chunks of the file
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(const MappedFile& file, const char row_sep, ThreadPool& pool)
+{
+    m_ParseText(file.Data(), file.Data() + file.Size(), row_sep, &pool);
+}
+
+/// @brief Copy constructor: the copy always owns a compact (contiguous) buffer
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(const Matrix& other) : m_modifications(other.m_modifications)
+{
+    m_Allocate(other.m_rows, other.m_cols);
+    for (std::size_t i{0U}; i < m_rows; ++i)
     {
-        std::vector<T> row;
-        std::istringstream streamline(line);
-        std::string tok;
-        if (row_sep != '\0')
-        {
-            while (getline(streamline, tok, row_sep))
-            {
-                auto value = T{};
-                std::from_chars(tok.data(), tok.data() + tok.size(), value);
-                row.push_back(value);
-            }
-            m_data.push_back(row);
-        }
-        else
-        {
-            while (getline(streamline, tok))
-            {
-                std::copy(tok.begin(), tok.end(), std::back_inserter(row));
-                m_data.push_back(row);
-            }
-        }
+        const T* src = other.m_data + other.m_Index(i, 0U);
+        std::copy(src, src + m_cols, m_data + m_Index(i, 0U));
+    }
+}
+
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>::Matrix(Matrix&& other) noexcept
+    : m_buffer(std::move(other.m_buffer)),
+      m_capacity(other.m_capacity),
+      m_data(other.m_data),
+      m_rows(other.m_rows),
+      m_cols(other.m_cols),
+      m_row_stride(other.m_row_stride),
+      m_owner(std::move(other.m_owner)),
+      m_modifications(other.m_modifications)
+{
+    ++other.m_modifications;
+    other.m_capacity = 0U;
+    other.m_data = nullptr;
+    other.m_rows = other.m_cols = other.m_row_stride = 0U;
+}
+
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>& Matrix<T, BoundsCheck>::operator=(const Matrix& other)
+{
+    if (this != &other)
+    {
+        Matrix<T, BoundsCheck> copy(other);
+        *this = std::move(copy);
     }
-    m_UpdateSize();
+    return *this;
+}
+
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck>& Matrix<T, BoundsCheck>::operator=(Matrix&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_buffer = std::move(other.m_buffer);
+        m_capacity = other.m_capacity;
+        m_data = other.m_data;
+        m_rows = other.m_rows;
+        m_cols = other.m_cols;
+        m_row_stride = other.m_row_stride;
+        m_owner = std::move(other.m_owner);
+        m_modifications = other.m_modifications;
+        ++other.m_modifications;
+        other.m_capacity = 0U;
+        other.m_data = nullptr;
+        other.m_rows = other.m_cols = other.m_row_stride = 0U;
+    }
+    return *this;
 }
 
 /// @brief Print the matrix
 /// @param row_sep Separator between rows (default is '\n')
 /// @param col_sep Separator between columns (default is ' ')
-template <typename T>
-void Matrix<T>::Print(char col_sep, char row_sep)
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::Print(char col_sep, char row_sep)
 {
     // TODO: Make correct choice of col separator depending on type of data ('\t' for numbers, ' ' for chars...)
     for (std::size_t i{0}; i < m_rows; ++i)
     {
         for (std::size_t j = 0; j < m_cols; ++j)
         {
-            std::cout << m_data[i][j] << col_sep;
+            std::cout << m_data[m_Index(i, j)] << col_sep;
         }
         std::cout << row_sep;
     }
@@ -221,13 +468,13 @@ void Matrix<T>::Print(char col_sep, char row_sep)
 /// @brief Get a submatrix "cutted" around a desired value, given the width of the window
 /// @param window_width Width of the window, must be an odd number
 /// @param fill_value Value to fill the "empty" space when the window is out of bounds. Uses type default as default
-template <typename T>
-Matrix<T> Matrix<T>::CutWindow(const std::size_t row,
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck> Matrix<T, BoundsCheck>::CutWindow(const std::size_t row,
                                const std::size_t col,
                                const std::size_t window_width,
                                const T fill_value)
 {
-    Matrix<T> submatrix(window_width, window_width, fill_value);
+    Matrix<T, BoundsCheck> submatrix(window_width, window_width, fill_value);
     if ((window_width > 1U) && (window_width <= std::min(NRows(), NCols())))
     {
         if (window_width % 2 == 0)
@@ -265,114 +512,742 @@ Matrix<T> Matrix<T>::CutWindow(const std::size_t row,
     return submatrix;
 }
 
+/// @brief Get the W x W window centered on an element, as a FixedMatrix (no allocation)
+/// @tparam W Width of the window, must be odd
+/// @param fill_value Value of the window cells out of the matrix. Uses type default as default
+template <typename T, typename BoundsCheck>
+template <std::size_t W>
+FixedMatrix<T, W, W, BoundsCheck> Matrix<T, BoundsCheck>::CutWindow(const std::size_t row,
+                                                                    const std::size_t col,
+                                                                    const T fill_value) const
+{
+    static_assert(W % 2U == 1U, "Matrix<T>::CutWindow<W>(row, col): W must be an odd number");
+    constexpr std::size_t half{W / 2U};
+    FixedMatrix<T, W, W, BoundsCheck> window;
+    if ((row >= half) && (col >= half) && (row + half < m_rows) && (col + half < m_cols))
+    {
+        // Window entirely inside the matrix: W row copies of compile-time length
+        const T* src = m_data + m_Index(row - half, col - half);
+        for (std::size_t i{0U}; i < W; ++i)
+            for (std::size_t j{0U}; j < W; ++j)
+                window[i][j] = src[i * m_row_stride + j];
+        return window;
+    }
+    window.Fill(fill_value);
+    for (std::size_t i{0U}; i < W; ++i)
+    {
+        // Unsigned wrap-around makes rows (columns) before the first one out of range as well
+        const std::size_t src_row{row + i - half};
+        if (src_row >= m_rows) continue;
+        for (std::size_t j{0U}; j < W; ++j)
+        {
+            const std::size_t src_col{col + j - half};
+            if (src_col < m_cols) window[i][j] = m_data[m_Index(src_row, src_col)];
+        }
+    }
+    return window;
+}
+
+/// @brief Visit the window_width x window_width window centered on every element (the same window CutWindow
+///        returns), row by row, without allocating a window per element
+/// @details The rows of the window are kept in one padded buffer of 2 * window_width rows: moving to the next column
+///          only moves the view by one element, moving to the next row loads one row of the matrix
+/// @param window_width Width of the window, must be an odd number
+/// @param fn Callable taking the row, the column and a MatrixView<const T> of the window (valid during the call only)
+/// @param fill_value Value of the window cells out of the matrix. Uses type default as default
+/// @param pool Thread pool to split the rows on (nullptr to run on the calling thread): fn is then called
+///        concurrently on different rows
+/// @throw std::out_of_range If window_width is zero or even
+template <typename T, typename BoundsCheck>
+template <typename F>
+void Matrix<T, BoundsCheck>::ForEachWindow(const std::size_t window_width,
+                                           F&& fn,
+                                           const T fill_value,
+                                           ThreadPool* pool) const
+{
+    if ((window_width == 0U) || (window_width % 2U == 0U))
+    {
+        throw std::out_of_range(
+            "Matrix<T>::ForEachWindow(window_width, fn): window_width must be an odd number");
+    }
+    if ((pool == nullptr) || (pool->Size() < 2U) || (m_rows < 2U))
+    {
+        m_WindowRows(0U, m_rows, window_width, fn, fill_value);
+        return;
+    }
+    const std::size_t n_bands{std::min(m_rows, pool->Size() * 2U)};
+    pool->ParallelFor(n_bands, [&](std::size_t band) {
+        m_WindowRows(band * m_rows / n_bands, (band + 1U) * m_rows / n_bands, window_width, fn, fill_value);
+    });
+}
+
+template <typename T, typename BoundsCheck>
+template <typename F>
+void Matrix<T, BoundsCheck>::m_WindowRows(const std::size_t first_row,
+                                          const std::size_t last_row,
+                                          const std::size_t window_width,
+                                          F& fn,
+                                          const T fill_value) const
+{
+    const std::size_t half{window_width / 2U};
+    const std::size_t padded_cols{m_cols + window_width - 1U};
+    const std::size_t buffer_rows{2U * window_width};
+    std::unique_ptr<T[]> buffer = std::make_unique<T[]>(buffer_rows * padded_cols);
+    // Copy a matrix row (fill_value out of the matrix, unsigned wrap-around included) padded by half on both sides
+    auto load = [&](T* dst, const std::size_t row) {
+        if (row >= m_rows)
+        {
+            std::fill(dst, dst + padded_cols, fill_value);
+            return;
+        }
+        const T* src = m_data + m_Index(row, 0U);
+        std::fill(dst, dst + half, fill_value);
+        std::copy(src, src + m_cols, dst + half);
+        std::fill(dst + half + m_cols, dst + padded_cols, fill_value);
+    };
+
+    std::size_t start{0U};                 // Buffer row holding the first row of the current window
+    std::size_t filled{window_width - 1U};  // Buffer rows loaded
+    for (std::size_t i{0U}; i < filled; ++i)
+        load(buffer.get() + i * padded_cols, first_row + i - half);
+    for (std::size_t row{first_row}; row < last_row; ++row, ++start)
+    {
+        if (filled == buffer_rows)
+        {
+            std::move(buffer.get() + start * padded_cols, buffer.get() + filled * padded_cols, buffer.get());
+            filled -= start;
+            start = 0U;
+        }
+        load(buffer.get() + (filled++) * padded_cols, row + half);
+        const T* window = buffer.get() + start * padded_cols;
+        for (std::size_t col{0U}; col < m_cols; ++col)
+            fn(row, col, MatrixView<const T>(window + col, window_width, window_width, padded_cols));
+    }
+}
+
 /// @brief Count and return the number of occurrences of the specified element
 /// @param searched_element Element to count
-template <typename T>
-const std::size_t Matrix<T>::CountElements(const T searched_element)
+template <typename T, typename BoundsCheck>
+std::size_t Matrix<T, BoundsCheck>::CountElements(const T searched_element) const
 {
     std::size_t matches{0U};
+    m_ForEachSpan([&matches, &searched_element](const T* span, const std::size_t size, const std::size_t) {
+        if constexpr (std::is_arithmetic_v<T>)
+            matches += simd::Count(span, size, searched_element);
+        else
+            matches += static_cast<std::size_t>(std::count(span, span + size, searched_element));
+    });
+    return matches;
+}
+
+/// @brief Find the first occurrence (in row-major order) of the specified element
+/// @return (row, col) of the element, std::nullopt if it is not in the matrix
+template <typename T, typename BoundsCheck>
+std::optional<std::pair<std::size_t, std::size_t>> Matrix<T, BoundsCheck>::Find(const T searched_element) const
+{
     for (std::size_t row{0U}; row < m_rows; ++row)
     {
-        for (std::size_t col{0U}; col < m_cols; ++col)
+        const T* span = m_data + m_Index(row, 0U);
+        std::size_t col;
+        if constexpr (std::is_arithmetic_v<T>)
+            col = simd::FindFirst(span, m_cols, searched_element);
+        else
+            col = static_cast<std::size_t>(std::find(span, span + m_cols, searched_element) - span);
+        if (col < m_cols) return std::make_pair(row, col);
+    }
+    return std::nullopt;
+}
+
+/// @brief Find all the occurrences (in row-major order) of the specified element
+/// @return (row, col) of every occurrence
+template <typename T, typename BoundsCheck>
+std::vector<std::pair<std::size_t, std::size_t>> Matrix<T, BoundsCheck>::FindAll(const T searched_element) const
+{
+    std::vector<std::pair<std::size_t, std::size_t>> positions;
+    m_ForEachSpan([this, &positions, &searched_element](const T* span, const std::size_t size, std::size_t first) {
+        auto on_match = [this, &positions, first](std::size_t i) {
+            const std::size_t index{first + i};
+            positions.emplace_back(index / m_row_stride, index % m_row_stride);
+        };
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            simd::ForEachMatch(span, size, searched_element, on_match);
+        }
+        else
+        {
+            for (std::size_t i{0U}; i < size; ++i)
+                if (span[i] == searched_element) on_match(i);
+        }
+    });
+    return positions;
+}
+
+/// @brief Replace every occurrence of an element with a new value
+/// @return Number of replaced elements
+template <typename T, typename BoundsCheck>
+std::size_t Matrix<T, BoundsCheck>::Replace(const T old_value, const T new_value)
+{
+    ++m_modifications;
+    std::size_t replaced{0U};
+    m_ForEachSpan([&replaced, &old_value, &new_value](T* out, const std::size_t size, const std::size_t) {
+        if constexpr (std::is_arithmetic_v<T>)
+        {
+            replaced += simd::Replace(out, size, old_value, new_value);
+        }
+        else
         {
-            if (this->operator()(row, col) == searched_element)
+            for (std::size_t i{0U}; i < size; ++i)
             {
-                matches++;
+                if (out[i] == old_value)
+                {
+                    out[i] = new_value;
+                    ++replaced;
+                }
             }
         }
-    }
-    return matches;
+    });
+    return replaced;
+}
+
+/// @brief Set every element of the matrix to value
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::Fill(const T value)
+{
+    ++m_modifications;
+    m_ForEachSpan([&value](T* span, const std::size_t size, const std::size_t) {
+        if constexpr (std::is_arithmetic_v<T>)
+            simd::Fill(span, size, value);
+        else
+            std::fill(span, span + size, value);
+    });
+}
+
+/// @brief Exchange the elements with another matrix of the same size in O(1), without copying them
+/// @throw std::length_error If the matrices have different dimensions
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::SwapData(Matrix& other)
+{
+    if ((m_rows != other.m_rows) || (m_cols != other.m_cols))
+        throw std::length_error("Matrix<T>::SwapData(other): Matrices must have the same dimensions");
+    std::swap(m_buffer, other.m_buffer);
+    std::swap(m_capacity, other.m_capacity);
+    std::swap(m_data, other.m_data);
+    std::swap(m_row_stride, other.m_row_stride);
+    std::swap(m_owner, other.m_owner);
+    ++m_modifications;
+    ++other.m_modifications;
 }
 
 /// @brief Insert a new row at the specified index
 /// @param index Index of the row after which insert the new row
 /// @param new_row New row
-template <typename T>
-void Matrix<T>::InsertRow(const std::size_t index, const std::vector<T> new_row)
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::InsertRow(const std::size_t index, const std::vector<T>& new_row)
+{
+    InsertRow(index, RowView<const T>(new_row));
+}
+
+/// @brief Insert a new row at the specified index, copying it from a view
+/// @param index Index of the row after which insert the new row
+/// @param new_row View over the new row (it may point inside this matrix)
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::InsertRow(const std::size_t index, RowView<const T> new_row)
 {
     if ((index > m_rows) || (new_row.size() != m_cols))
     {
         throw std::length_error("Matrix<T>::InsertRow(index, new_row): Check index value and new_row length");
     }
-    auto it = m_data.begin();
-    m_data.insert(it + index, new_row);
-    m_UpdateSize();
+    if (m_Aliases(new_row.data()))
+    {
+        // The new row lives inside this matrix, copy it before shifting the rows
+        InsertRow(index, new_row.ToVector());
+        return;
+    }
+    if ((m_rows + 1U) * m_row_stride > m_capacity)
+    {
+        m_Reserve(std::max((m_rows + 1U) * m_row_stride, 2U * m_capacity));
+    }
+    T* row_begin = m_data + m_Index(index, 0U);
+    std::move_backward(row_begin, m_data + m_Index(m_rows, 0U), m_data + m_Index(m_rows + 1U, 0U));
+    std::copy(new_row.begin(), new_row.end(), row_begin);
+    ++m_rows;
+    ++m_modifications;
 }
 
 /// @brief Insert a new column at the specified index
 /// @param index Index of the column after which insert the new column
 /// @param new_column New column
-template <typename T>
-void Matrix<T>::InsertColumn(const std::size_t index, const std::vector<T> new_column)
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::InsertColumn(const std::size_t index, const std::vector<T>& new_column)
+{
+    InsertColumn(index, ColumnView<const T>(new_column));
+}
+
+/// @brief Insert a new column at the specified index, copying it from a view
+/// @param index Index of the column after which insert the new column
+/// @param new_column View over the new column (it may point inside this matrix)
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::InsertColumn(const std::size_t index, ColumnView<const T> new_column)
 {
     if ((index > m_cols) || (new_column.size() != m_rows))
     {
         throw std::length_error("Matrix<T>::InsertColumn(index, new_column): Check index value and new_column length");
     }
-    std::size_t i{0U};
-    std::for_each(m_data.begin(), m_data.end(), [index, new_column, &i](std::vector<T>& v) {
-        v.insert(v.begin() + index, new_column[i++]);
-    });
-    m_UpdateSize();
+    const std::size_t new_cols{m_cols + 1U};
+    std::unique_ptr<T[]> buffer = std::make_unique<T[]>(m_rows * new_cols);
+    for (std::size_t i{0U}; i < m_rows; ++i)
+    {
+        T* src = m_data + m_Index(i, 0U);
+        T* dst = buffer.get() + i * new_cols;
+        std::move(src, src + index, dst);
+        dst[index] = new_column[i];
+        std::move(src + index, src + m_cols, dst + index + 1U);
+    }
+    m_buffer = std::move(buffer);
+    m_capacity = m_rows * new_cols;
+    m_data = m_buffer.get();
+    m_owner.reset();
+    m_cols = new_cols;
+    m_row_stride = new_cols;
+    ++m_modifications;
 }
 
-/// @brief Unpack a unidimensional matrix to m_data, using m_rows and m_cols as dimensions
-/// @param flat_matrix std::vector containing the elements of the matrix
-template <typename T>
-void Matrix<T>::m_UnpackFlatMatrix(std::vector<T> flat_matrix)
+/// @brief Remove a row, shifting the following rows in place
+/// @param index Index of the row to remove
+/// @throw std::out_of_range If the row does not exist
+/// @throw std::length_error If it is the last row of the matrix
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::RemoveRow(const std::size_t index)
+{
+    if (index >= m_rows) throw std::out_of_range("Matrix<T>::RemoveRow(index): Index is out of range");
+    if (m_rows == 1U) throw std::length_error("Matrix<T>::RemoveRow(index): Cannot remove the last row");
+    for (std::size_t i{index + 1U}; i < m_rows; ++i)
+    {
+        T* src = m_data + m_Index(i, 0U);
+        std::move(src, src + m_cols, m_data + m_Index(i - 1U, 0U));
+    }
+    --m_rows;
+    ++m_modifications;
+}
+
+/// @brief Remove a column, compacting the rows in place
+/// @param index Index of the column to remove
+/// @throw std::out_of_range If the column does not exist
+/// @throw std::length_error If it is the last column of the matrix
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::RemoveColumn(const std::size_t index)
 {
-    std::size_t index = 0U;
+    if (index >= m_cols) throw std::out_of_range("Matrix<T>::RemoveColumn(index): Index is out of range");
+    if (m_cols == 1U) throw std::length_error("Matrix<T>::RemoveColumn(index): Cannot remove the last column");
+    const std::size_t new_cols{m_cols - 1U};
+    // Destinations never pass their sources: moving forward row by row is safe
     for (std::size_t i{0U}; i < m_rows; ++i)
     {
-        std::vector<T> row;
-        for (std::size_t j{0U}; j < m_cols; ++j)
+        T* src = m_data + m_Index(i, 0U);
+        T* dst = m_data + i * new_cols;
+        std::move(src, src + index, dst);
+        std::move(src + index + 1U, src + m_cols, dst + index);
+    }
+    m_cols = new_cols;
+    m_row_stride = new_cols;
+    ++m_modifications;
+}
+
+/// @brief Apply a batch of structural edits in a single pass over the elements, O(rows x cols) whatever the number
+///        of edits (see MatrixEdits for the semantics of the indices)
+/// @throw std::out_of_range If an index is out of range
+/// @throw std::length_error If an inserted row (column) does not have the final number of columns (rows), or if
+///        the edits remove every row (column)
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::ApplyEdits(const MatrixEdits<T>& edits)
+{
+    // Final layout of one dimension: every entry is an original index, or kInserted + the index of an insert
+    constexpr std::size_t kInserted{std::size_t{1} << (sizeof(std::size_t) * 8U - 1U)};
+    auto layout = [](const std::size_t n, const auto& inserts, const std::vector<std::size_t>& removals,
+                     const char* what) {
+        std::vector<bool> removed(n, false);
+        for (const std::size_t index : removals)
+        {
+            if (index >= n) throw std::out_of_range(std::string("Matrix<T>::ApplyEdits(edits): ") + what);
+            removed[index] = true;
+        }
+        std::vector<std::size_t> order(inserts.size());
+        for (std::size_t k{0U}; k < inserts.size(); ++k)
+        {
+            if (inserts[k].first > n) throw std::out_of_range(std::string("Matrix<T>::ApplyEdits(edits): ") + what);
+            order[k] = k;
+        }
+        std::stable_sort(order.begin(), order.end(),
+                         [&inserts](std::size_t a, std::size_t b) { return inserts[a].first < inserts[b].first; });
+        std::vector<std::size_t> result;
+        result.reserve(n + inserts.size());
+        std::size_t next{0U};
+        for (std::size_t i{0U}; i <= n; ++i)
+        {
+            for (; (next < order.size()) && (inserts[order[next]].first == i); ++next)
+                result.push_back(kInserted | order[next]);
+            if ((i < n) && !removed[i]) result.push_back(i);
+        }
+        return result;
+    };
+    const std::vector<std::size_t> rows = layout(m_rows, edits.RowInserts(), edits.RowRemovals(), "Row index is out of range");
+    const std::vector<std::size_t> cols =
+        layout(m_cols, edits.ColumnInserts(), edits.ColumnRemovals(), "Column index is out of range");
+    if (rows.empty() || cols.empty())
+        throw std::length_error("Matrix<T>::ApplyEdits(edits): Cannot remove every row or column");
+    for (const auto& [index, values] : edits.RowInserts())
+    {
+        if (values.size() != cols.size())
+            throw std::length_error("Matrix<T>::ApplyEdits(edits): Inserted rows must have the final number of columns");
+    }
+    for (const auto& [index, values] : edits.ColumnInserts())
+    {
+        if (values.size() != rows.size())
+            throw std::length_error("Matrix<T>::ApplyEdits(edits): Inserted columns must have the final number of rows");
+    }
+
+    std::unique_ptr<T[]> buffer = std::make_unique<T[]>(rows.size() * cols.size());
+    for (std::size_t i{0U}; i < rows.size(); ++i)
+    {
+        T* dst = buffer.get() + i * cols.size();
+        if (rows[i] & kInserted)
         {
-            row.push_back(flat_matrix[index++]);
+            const std::vector<T>& values = edits.RowInserts()[rows[i] & ~kInserted].second;
+            std::copy(values.begin(), values.end(), dst);
+            continue;
         }
-        m_data.push_back(row);
+        const T* src = m_data + m_Index(rows[i], 0U);
+        for (std::size_t j{0U}; j < cols.size(); ++j)
+            dst[j] = (cols[j] & kInserted) ? edits.ColumnInserts()[cols[j] & ~kInserted].second[i] : src[cols[j]];
     }
+    m_buffer = std::move(buffer);
+    m_capacity = rows.size() * cols.size();
+    m_data = m_buffer.get();
+    m_owner.reset();
+    m_rows = rows.size();
+    m_cols = cols.size();
+    m_row_stride = m_cols;
+    ++m_modifications;
+}
+
+/// @brief Write a binary snapshot of the matrix, which LoadSnapshot maps back without parsing
+/// @param out Binary output stream
+/// @throw std::ios_base::failure If the snapshot cannot be written
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::SaveSnapshot(std::ostream& out) const
+{
+    m_WriteSnapshot(out, SnapshotKind::kSnapshotKind_Matrix, std::string());
+}
+
+/// @brief Write a binary snapshot of the matrix to a file
+/// @param path Path of the file (overwritten)
+/// @throw std::ios_base::failure If the file cannot be written
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::SaveSnapshot(const std::string& path) const
+{
+    std::ofstream fp(path, std::ios::binary | std::ios::trunc);
+    if (!fp) throw std::ios_base::failure("Matrix<T>::SaveSnapshot(path): Cannot open file");
+    SaveSnapshot(fp);
+}
+
+/// @brief Restore a matrix from a snapshot: the elements are borrowed from the mapped file, no element is copied
+///        or converted (writes go to private copy-on-write pages, the file is never modified)
+/// @param file Mapped snapshot, kept alive by the matrix
+/// @param verify_checksum Whether to verify the checksum (one read-only pass over the mapped bytes)
+/// @throw std::invalid_argument If the file is not a valid snapshot of a Matrix<T> (see ReadSnapshotHeader)
+/// @throw std::length_error If the snapshot records 0 rows or 0 columns
+template <typename T, typename BoundsCheck>
+Matrix<T, BoundsCheck> Matrix<T, BoundsCheck>::LoadSnapshot(std::shared_ptr<MappedFile> file, const bool verify_checksum)
+{
+    Matrix matrix;
+    matrix.m_BorrowSnapshot(std::move(file), verify_checksum);
+    return matrix;
+}
+
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::m_WriteSnapshot(std::ostream& out, const SnapshotKind kind, const std::string& metadata) const
+{
+    SnapshotHeader header = MakeSnapshotHeader<T>(kind, m_rows, m_cols, metadata.size());
+    SnapshotHasher hasher;
+    m_ForEachSpan([&hasher](const T* span, const std::size_t size, std::size_t) {
+        hasher.Update(span, size * sizeof(T));
+    });
+    hasher.Update(metadata.data(), metadata.size());
+    header.checksum = hasher.Digest();
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    m_ForEachSpan([&out](const T* span, const std::size_t size, std::size_t) {
+        out.write(reinterpret_cast<const char*>(span), static_cast<std::streamsize>(size * sizeof(T)));
+    });
+    out.write(metadata.data(), static_cast<std::streamsize>(metadata.size()));
+    if (!out) throw std::ios_base::failure("Matrix<T>::SaveSnapshot(out): Cannot write snapshot");
+}
+
+/// @brief Validate a mapped snapshot and make the matrix borrow its elements
+/// @return The header of the snapshot (the metadata follow the elements in the file)
+template <typename T, typename BoundsCheck>
+SnapshotHeader Matrix<T, BoundsCheck>::m_BorrowSnapshot(std::shared_ptr<MappedFile> file, const bool verify_checksum)
+{
+    const SnapshotHeader header = ReadSnapshotHeader(file->Data(), file->Size(), SnapshotTypeTag<T>(), verify_checksum);
+    // mmap returns page-aligned memory: the elements, right after the 64-byte header, are aligned for any T
+    m_buffer.reset();
+    m_capacity = 0U;
+    m_data = (header.data_size > 0U) ? reinterpret_cast<T*>(file->Data() + sizeof(SnapshotHeader)) : nullptr;
+    m_rows = static_cast<std::size_t>(header.n_rows);
+    m_cols = static_cast<std::size_t>(header.n_cols);
+    m_row_stride = m_cols;
+    m_owner = std::move(file);
+    return header;
+}
+
+/// @brief Read the whole content of a file stream (from the current position)
+template <typename T, typename BoundsCheck>
+std::string Matrix<T, BoundsCheck>::m_ReadAll(std::ifstream& fp)
+{
+    std::string text;
+    const auto begin = fp.tellg();
+    fp.seekg(0, std::ios::end);
+    const auto end = fp.tellg();
+    if ((begin >= 0) && (end >= begin))
+    {
+        text.resize(static_cast<std::size_t>(end - begin));
+        fp.seekg(begin);
+        fp.read(text.data(), static_cast<std::streamsize>(text.size()));
+        text.resize(static_cast<std::size_t>(fp.gcount()));
+    }
+    else
+    {
+        fp.clear();
+        text.assign(std::istreambuf_iterator<char>(fp), std::istreambuf_iterator<char>());
+    }
+    return text;
+}
+
+/// @brief Return the end of the line starting at begin (pointer to its '\n', or to end)
+template <typename T, typename BoundsCheck>
+const char* Matrix<T, BoundsCheck>::m_LineEnd(const char* begin, const char* end)
+{
+    const void* newline = std::memchr(begin, '\n', static_cast<std::size_t>(end - begin));
+    return (newline == nullptr) ? end : static_cast<const char*>(newline);
+}
+
+/// @brief Parse a text made of lines of elements, allocating the matrix and writing the values in place
+/// @details Delimiters are located in bulk (see ScanDelimited) and every cell is converted straight from the text.
+///          With a pool, the text is split in chunks at newline boundaries: the rows of every chunk are counted in
+///          parallel, then every chunk is parsed in parallel straight into the final position of its rows
+/// @param row_sep The separator used between elements ('\0' if every character is an element)
+/// @param pool Thread pool to use (nullptr to parse on the calling thread)
+/// @throw std::length_error If the text is empty or not all rows have the same length
+/// @throw commonlib::ParseError If a cell does not hold a valid value of type T
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::m_ParseText(const char* begin, const char* end, const char row_sep, ThreadPool* pool)
+{
+    // The first non-empty line gives the number of columns
+    const char* first = begin;
+    const char* first_end = m_LineEnd(first, end);
+    while ((first < end) && ((first_end == first) || ((first_end == first + 1) && (*first == '\r'))))
+    {
+        first = first_end + 1;
+        first_end = (first < end) ? m_LineEnd(first, end) : end;
+    }
+    if (first >= end)
+        throw std::length_error("Matrix<T>::Matrix(fp): Dimensions cannot be 0");
+    if ((first_end > first) && (first_end[-1] == '\r')) --first_end;
+    const std::size_t n_cols{(row_sep == '\0') ? static_cast<std::size_t>(first_end - first)
+                                                : CountChar(first, first_end, row_sep) + 1U};
+
+    if ((pool == nullptr) || (pool->Size() < 2U))
+    {
+        // Newlines give an upper bound of the number of rows
+        m_Allocate(CountChar(first, end, '\n') + 1U, n_cols);
+        m_rows = m_ParseRows(first, end, row_sep, 0U);
+        return;
+    }
+
+    // Split the text in chunks starting right after a newline
+    const std::size_t n_chunks{pool->Size() * 4U};
+    const std::size_t chunk_size{std::max<std::size_t>(static_cast<std::size_t>(end - first) / n_chunks, 1U)};
+    std::vector<const char*> bounds{first};
+    while (bounds.back() < end)
+    {
+        const char* cut = bounds.back() + std::min(chunk_size, static_cast<std::size_t>(end - bounds.back()));
+        bounds.push_back((cut < end) ? std::min(m_LineEnd(cut, end) + 1, end) : end);
+    }
+
+    std::vector<std::size_t> row_offsets(bounds.size(), 0U);
+    pool->ParallelFor(bounds.size() - 1U,
+                      [&](std::size_t i) { row_offsets[i + 1U] = m_CountRows(bounds[i], bounds[i + 1U]); });
+    for (std::size_t i{1U}; i < row_offsets.size(); ++i)
+        row_offsets[i] += row_offsets[i - 1U];
+
+    m_Allocate(row_offsets.back(), n_cols);
+    pool->ParallelFor(bounds.size() - 1U,
+                      [&](std::size_t i) { m_ParseRows(bounds[i], bounds[i + 1U], row_sep, row_offsets[i]); });
+}
+
+/// @brief Count the non-empty lines in [begin, end)
+template <typename T, typename BoundsCheck>
+std::size_t Matrix<T, BoundsCheck>::m_CountRows(const char* begin, const char* end)
+{
+    std::size_t n_rows{0U};
+    for (const char* line = begin; line < end;)
+    {
+        const char* newline = m_LineEnd(line, end);
+        const char* line_end = ((newline > line) && (newline[-1] == '\r')) ? (newline - 1) : newline;
+        if (line_end > line) ++n_rows;
+        line = newline + 1;
+    }
+    return n_rows;
+}
+
+/// @brief Parse the rows found in [begin, end) (which must start at the beginning of a line) into the allocated matrix
+/// @param row_sep The separator used between elements ('\0' if every character is an element)
+/// @param first_row Index of the matrix row where the first parsed row is written
+/// @return Number of parsed rows
+template <typename T, typename BoundsCheck>
+std::size_t Matrix<T, BoundsCheck>::m_ParseRows(const char* begin, const char* end, const char row_sep, const std::size_t first_row)
+{
+    return ParseRows(begin, end, row_sep, m_data + m_Index(first_row, 0U), m_cols, m_row_stride, first_row,
+                     "Matrix<T>::Matrix(fp)");
+}
+
+/// @brief Parse the first line of a text as a flat (comma-separated) matrix of n_rows x n_cols elements
+/// @throw std::length_error If the number of elements is not equal to n_rows * n_cols
+/// @throw commonlib::ParseError If a cell does not hold a valid value of type T
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::m_ParseFlat(const char* begin, const char* end, const std::size_t n_rows, const std::size_t n_cols)
+{
+    if ((n_rows == 0) || (n_cols == 0))
+        throw std::length_error("Matrix<T>::Matrix(fp, n_rows, n_cols): Dimensions cannot be 0");
+    m_Allocate(n_rows, n_cols);
+    const std::size_t n_elements{n_rows * n_cols};
+    std::size_t index{0U};
+    ScanDelimited(
+        begin,
+        m_LineEnd(begin, end),
+        ',',
+        [&](const char* tok, const char* tok_end) {
+            if (index >= n_elements)
+            {
+                throw std::length_error(
+                    "Matrix<T>::Matrix(fp, n_rows, n_cols): Flat_matrix length is not equal to n_rows*n_cols");
+            }
+            if (!ParseCell(tok, tok_end, m_data[index]))
+                throw ParseError("Matrix<T>::Matrix(fp, n_rows, n_cols)", index / n_cols, index % n_cols);
+            ++index;
+        },
+        []() {});
+    if (index != n_elements)
+        throw std::length_error(
+            "Matrix<T>::Matrix(fp, n_rows, n_cols): Flat_matrix length is not equal to n_rows*n_cols");
+}
+
+/// @brief Allocate a new compact owned buffer of n_rows x n_cols default-initialized elements
+/// @param capacity Number of elements to allocate (at least n_rows * n_cols)
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::m_Allocate(const std::size_t n_rows, const std::size_t n_cols, const std::size_t capacity)
+{
+    m_capacity = std::max(capacity, n_rows * n_cols);
+    m_buffer = std::make_unique<T[]>(m_capacity);
+    m_data = m_buffer.get();
+    m_owner.reset();
+    m_rows = n_rows;
+    m_cols = n_cols;
+    m_row_stride = n_cols;
+}
+
+/// @brief Move the elements to a new compact owned buffer able to hold at least capacity elements
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::m_Reserve(const std::size_t capacity)
+{
+    std::unique_ptr<T[]> buffer = std::make_unique<T[]>(std::max(capacity, m_rows * m_cols));
+    for (std::size_t i{0U}; i < m_rows; ++i)
+    {
+        T* src = m_data + m_Index(i, 0U);
+        std::move(src, src + m_cols, buffer.get() + i * m_cols);
+    }
+    m_capacity = std::max(capacity, m_rows * m_cols);
+    m_buffer = std::move(buffer);
+    m_data = m_buffer.get();
+    m_row_stride = m_cols;
+    m_owner.reset();
 }
 
 /// @brief Propagate the matrix on the right, copying it keeping the column order (|ABC|ABC|...|)
 /// @param times How many times copy the matrix
-template <typename T>
-void Matrix<T>::PropagateHorizontally(const std::size_t times)
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::PropagateHorizontally(const std::size_t times)
+{
+    if (times > 0U) Tile(1U, times + 1U);
+}
+
+/// @brief Propagate the matrix downwards, copying it keeping the row order
+/// @param times How many times copy the matrix
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::PropagateVertically(const std::size_t times)
+{
+    if (times > 0U) Tile(times + 1U, 1U);
+}
+
+/// @brief Repeat the matrix in both directions, in a single pass over a buffer allocated once
+/// @details Every row is repeated n_col_copies times, then the resulting block of rows is copied n_row_copies - 1
+///          times. Use Tiled() to read a repetition without materializing it
+/// @param n_row_copies Number of copies stacked vertically (1 to keep the rows)
+/// @param n_col_copies Number of copies side by side (1 to keep the columns)
+/// @throw std::length_error If a number of copies is 0
+template <typename T, typename BoundsCheck>
+void Matrix<T, BoundsCheck>::Tile(const std::size_t n_row_copies, const std::size_t n_col_copies)
 {
-    const std::size_t cols = NCols();
-    for (std::size_t i = 0U; i < times; ++i)
+    if ((n_row_copies == 0U) || (n_col_copies == 0U))
+        throw std::length_error("Matrix<T>::Tile(n_row_copies, n_col_copies): Number of copies cannot be 0");
+    const std::size_t n_rows{m_rows * n_row_copies};
+    const std::size_t n_cols{m_cols * n_col_copies};
+    std::unique_ptr<T[]> buffer = std::make_unique<T[]>(n_rows * n_cols);
+    for (std::size_t row{0U}; row < m_rows; ++row)
     {
-        for (std::size_t j = 0U; j < cols; ++j)
-        {
-            InsertColumn(NCols(), Column(j));
-            m_UpdateSize();
-        }
+        const T* src = m_data + m_Index(row, 0U);
+        T* dst = buffer.get() + row * n_cols;
+        for (std::size_t copy{0U}; copy < n_col_copies; ++copy)
+            std::copy(src, src + m_cols, dst + copy * m_cols);
     }
+    const std::size_t block{m_rows * n_cols};
+    for (std::size_t copy{1U}; copy < n_row_copies; ++copy)
+        std::copy(buffer.get(), buffer.get() + block, buffer.get() + copy * block);
+
+    m_buffer = std::move(buffer);
+    m_capacity = n_rows * n_cols;
+    m_data = m_buffer.get();
+    m_rows = n_rows;
+    m_cols = n_cols;
+    m_row_stride = n_cols;
+    m_owner.reset();
+    ++m_modifications;
 }
 
-template <typename T>
-T& Matrix<T>::operator()(const std::size_t row, const std::size_t col)
+template <typename T, typename BoundsCheck>
+T& Matrix<T, BoundsCheck>::operator()(const std::size_t row, const std::size_t col)
 {
-    if (row >= m_rows || col >= m_cols) throw std::out_of_range("Matrix<T>::operator(): Index is out of range");
-    return m_data[row][col];
+    BoundsCheck::Check((row < m_rows) && (col < m_cols), "Matrix<T>::operator(): Index is out of range");
+    return m_data[m_Index(row, col)];
 }
 
-template <typename T>
-T const& Matrix<T>::operator()(const std::size_t row, const std::size_t col) const
+template <typename T, typename BoundsCheck>
+T const& Matrix<T, BoundsCheck>::operator()(const std::size_t row, const std::size_t col) const
 {
-    if (row >= m_rows || col >= m_cols) throw std::out_of_range("Matrix<T>::operator(): Index is out of range");
-    return m_data[row][col];
+    BoundsCheck::Check((row < m_rows) && (col < m_cols), "Matrix<T>::operator(): Index is out of range");
+    return m_data[m_Index(row, col)];
 }
 
-template <typename T>
-bool operator==(const Matrix<T>& lhs, const Matrix<T>& rhs)
+template <typename T, typename BoundsCheck>
+bool operator==(const Matrix<T, BoundsCheck>& lhs, const Matrix<T, BoundsCheck>& rhs)
 {
-    return lhs.Data() == rhs.Data();
+    return lhs.View() == rhs.View();
 }
 
-template <typename T>
-bool operator!=(const Matrix<T>& lhs, const Matrix<T>& rhs)
+template <typename T, typename BoundsCheck>
+bool operator!=(const Matrix<T, BoundsCheck>& lhs, const Matrix<T, BoundsCheck>& rhs)
 {
-    return lhs.Data() != rhs.Data();
+    return !(lhs.View() == rhs.View());
 }
 
 }  // namespace commonlib
@@ -0,0 +1,382 @@
+/// @file matrix_view.h
+/// @author Alberto Santagostino
+
+#ifndef DATA_STRUCTURES_MATRIX_VIEW_H
+#define DATA_STRUCTURES_MATRIX_VIEW_H
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+namespace commonlib
+{
+/// @class StridedView
+/// @brief Non-owning 1D view over size elements placed stride elements apart (a row, a column, ...)
+/// @tparam T Type of the viewed elements (const-qualify it for read-only views)
+template <typename T>
+class StridedView
+{
+  public:
+    using value_type = std::remove_const_t<T>;
+
+    /// @brief Random access iterator over the viewed elements
+    class iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = std::remove_const_t<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = T*;
+        using reference = T&;
+
+        iterator() = default;
+        iterator(T* ptr, std::ptrdiff_t stride) : m_ptr(ptr), m_stride(stride) {}
+
+        inline T& operator*() const { return *m_ptr; }
+        inline T* operator->() const { return m_ptr; }
+        inline T& operator[](difference_type n) const { return m_ptr[n * m_stride]; }
+        inline iterator& operator++()
+        {
+            m_ptr += m_stride;
+            return *this;
+        }
+        inline iterator operator++(int)
+        {
+            iterator tmp(*this);
+            m_ptr += m_stride;
+            return tmp;
+        }
+        inline iterator& operator--()
+        {
+            m_ptr -= m_stride;
+            return *this;
+        }
+        inline iterator operator--(int)
+        {
+            iterator tmp(*this);
+            m_ptr -= m_stride;
+            return tmp;
+        }
+        inline iterator& operator+=(difference_type n)
+        {
+            m_ptr += n * m_stride;
+            return *this;
+        }
+        inline iterator& operator-=(difference_type n)
+        {
+            m_ptr -= n * m_stride;
+            return *this;
+        }
+        inline iterator operator+(difference_type n) const { return iterator(m_ptr + n * m_stride, m_stride); }
+        inline iterator operator-(difference_type n) const { return iterator(m_ptr - n * m_stride, m_stride); }
+        inline friend iterator operator+(difference_type n, const iterator& it) { return it + n; }
+        inline difference_type operator-(const iterator& other) const { return (m_ptr - other.m_ptr) / m_stride; }
+        inline bool operator==(const iterator& other) const { return m_ptr == other.m_ptr; }
+        inline bool operator!=(const iterator& other) const { return m_ptr != other.m_ptr; }
+        inline bool operator<(const iterator& other) const { return (*this - other) < 0; }
+        inline bool operator>(const iterator& other) const { return other < *this; }
+        inline bool operator<=(const iterator& other) const { return !(other < *this); }
+        inline bool operator>=(const iterator& other) const { return !(*this < other); }
+
+      private:
+        T* m_ptr{nullptr};
+        std::ptrdiff_t m_stride{1};
+    };
+    using const_iterator = iterator;
+
+    // Constructors
+    StridedView() = default;
+    StridedView(T* data, const std::size_t size, const std::size_t stride = 1U)
+        : m_data(data), m_size(size), m_stride(stride)
+    {}
+    /// @brief Implicit conversion from a mutable view to a read-only view
+    template <typename U>
+    StridedView(const StridedView<U>& other) requires(std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+        : m_data(other.data()), m_size(other.size()), m_stride(other.Stride())
+    {}
+    /// @brief View over the whole content of a vector
+    StridedView(std::vector<value_type>& vec) : m_data(vec.data()), m_size(vec.size()), m_stride(1U) {}
+    StridedView(const std::vector<value_type>& vec) requires std::is_const_v<T>
+        : m_data(vec.data()), m_size(vec.size()), m_stride(1U)
+    {}
+
+    // Getters
+    inline T* data() const { return m_data; }
+    inline std::size_t size() const { return m_size; }
+    inline bool empty() const { return m_size == 0U; }
+    inline std::size_t Stride() const { return m_stride; }
+    inline iterator begin() const { return iterator(m_data, std::ptrdiff_t(m_stride)); }
+    inline iterator end() const { return iterator(m_data + m_size * m_stride, std::ptrdiff_t(m_stride)); }
+    inline std::vector<value_type> ToVector() const { return std::vector<value_type>(begin(), end()); }
+
+    // Operators
+    inline T& operator[](const std::size_t i) const { return m_data[i * m_stride]; }
+    T& at(const std::size_t i) const
+    {
+        if (i >= m_size) throw std::out_of_range("StridedView<T>::at(): Index is out of range");
+        return m_data[i * m_stride];
+    }
+
+    template <typename U>
+    bool operator==(const StridedView<U>& other) const
+    {
+        if (m_size != other.size()) return false;
+        for (std::size_t i{0U}; i < m_size; ++i)
+        {
+            if (!(m_data[i * m_stride] == other[i])) return false;
+        }
+        return true;
+    }
+    bool operator==(const std::vector<value_type>& other) const
+    {
+        if (m_size != other.size()) return false;
+        for (std::size_t i{0U}; i < m_size; ++i)
+        {
+            if (!(m_data[i * m_stride] == other[i])) return false;
+        }
+        return true;
+    }
+
+  private:
+    T* m_data{nullptr};
+    std::size_t m_size{0U};
+    std::size_t m_stride{1U};
+};
+
+/// @brief View over a single (contiguous) matrix row
+template <typename T>
+using RowView = StridedView<T>;
+
+/// @brief View over a single matrix column (elements are one row stride apart)
+template <typename T>
+using ColumnView = StridedView<T>;
+
+/// @class MatrixView
+/// @brief Non-owning 2D view over a rectangular region of a row-major matrix
+/// @tparam T Type of the viewed elements (const-qualify it for read-only views)
+template <typename T>
+class MatrixView
+{
+  public:
+    using value_type = RowView<T>;
+
+    /// @brief Iterator over the rows of the view
+    class iterator
+    {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = RowView<T>;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = RowView<T>;
+
+        iterator() = default;
+        iterator(const MatrixView* view, std::size_t row) : m_view(view), m_row(row) {}
+
+        inline RowView<T> operator*() const { return m_view->Row(m_row); }
+        inline RowView<T> operator[](difference_type n) const { return m_view->Row(m_row + n); }
+        inline iterator& operator++()
+        {
+            ++m_row;
+            return *this;
+        }
+        inline iterator operator++(int)
+        {
+            iterator tmp(*this);
+            ++m_row;
+            return tmp;
+        }
+        inline iterator& operator--()
+        {
+            --m_row;
+            return *this;
+        }
+        inline iterator operator--(int)
+        {
+            iterator tmp(*this);
+            --m_row;
+            return tmp;
+        }
+        inline iterator& operator+=(difference_type n)
+        {
+            m_row += n;
+            return *this;
+        }
+        inline iterator& operator-=(difference_type n)
+        {
+            m_row -= n;
+            return *this;
+        }
+        inline iterator operator+(difference_type n) const { return iterator(m_view, m_row + n); }
+        inline iterator operator-(difference_type n) const { return iterator(m_view, m_row - n); }
+        inline difference_type operator-(const iterator& other) const
+        {
+            return difference_type(m_row) - difference_type(other.m_row);
+        }
+        inline bool operator==(const iterator& other) const { return m_row == other.m_row; }
+        inline bool operator!=(const iterator& other) const { return m_row != other.m_row; }
+        inline bool operator<(const iterator& other) const { return m_row < other.m_row; }
+
+      private:
+        const MatrixView* m_view{nullptr};
+        std::size_t m_row{0U};
+    };
+    using const_iterator = iterator;
+
+    // Constructors
+    MatrixView() = default;
+    MatrixView(T* data, const std::size_t n_rows, const std::size_t n_cols, const std::size_t row_stride)
+        : m_data(data), m_rows(n_rows), m_cols(n_cols), m_row_stride(row_stride)
+    {}
+    /// @brief Implicit conversion from a mutable view to a read-only view
+    template <typename U>
+    MatrixView(const MatrixView<U>& other) requires(std::is_same_v<const U, T> && !std::is_same_v<U, T>)
+        : m_data(other.data()), m_rows(other.NRows()), m_cols(other.NCols()), m_row_stride(other.RowStride())
+    {}
+
+    // Getters
+    inline T* data() const { return m_data; }
+    inline std::size_t NRows() const { return m_rows; }
+    inline std::size_t NCols() const { return m_cols; }
+    inline std::size_t RowStride() const { return m_row_stride; }
+    inline bool IsContiguous() const { return m_row_stride == m_cols; }
+    inline std::size_t size() const { return m_rows; }
+    inline bool empty() const { return m_rows == 0U; }
+    inline iterator begin() const { return iterator(this, 0U); }
+    inline iterator end() const { return iterator(this, m_rows); }
+    inline RowView<T> Row(const std::size_t row) const { return RowView<T>(m_data + row * m_row_stride, m_cols, 1U); }
+    inline ColumnView<T> Column(const std::size_t col) const
+    {
+        return ColumnView<T>(m_data + col, m_rows, m_row_stride);
+    }
+    MatrixView SubView(const std::size_t row,
+                       const std::size_t col,
+                       const std::size_t n_rows,
+                       const std::size_t n_cols) const;
+    std::vector<std::vector<std::remove_const_t<T>>> ToVector() const;
+
+    // Operators
+    inline T& operator()(const std::size_t row, const std::size_t col) const
+    {
+        return m_data[row * m_row_stride + col];
+    }
+    inline RowView<T> operator[](const std::size_t row) const { return Row(row); }
+
+    template <typename U>
+    bool operator==(const MatrixView<U>& other) const
+    {
+        if ((m_rows != other.NRows()) || (m_cols != other.NCols())) return false;
+        for (std::size_t i{0U}; i < m_rows; ++i)
+        {
+            if (!(Row(i) == other.Row(i))) return false;
+        }
+        return true;
+    }
+    bool operator==(const std::vector<std::vector<std::remove_const_t<T>>>& other) const
+    {
+        if (m_rows != other.size()) return false;
+        for (std::size_t i{0U}; i < m_rows; ++i)
+        {
+            if (!(Row(i) == other[i])) return false;
+        }
+        return true;
+    }
+
+  private:
+    T* m_data{nullptr};
+    std::size_t m_rows{0U};
+    std::size_t m_cols{0U};
+    std::size_t m_row_stride{0U};
+};
+
+/// @brief Get a view over the rectangular region starting at (row, col)
+/// @param n_rows Number of rows of the region
+/// @param n_cols Number of columns of the region
+/// @throw std::out_of_range If the region does not fit inside the view
+template <typename T>
+MatrixView<T> MatrixView<T>::SubView(const std::size_t row,
+                                     const std::size_t col,
+                                     const std::size_t n_rows,
+                                     const std::size_t n_cols) const
+{
+    if ((row + n_rows > m_rows) || (col + n_cols > m_cols))
+        throw std::out_of_range("MatrixView<T>::SubView(row, col, n_rows, n_cols): Region is out of range");
+    return MatrixView<T>(m_data + row * m_row_stride + col, n_rows, n_cols, m_row_stride);
+}
+
+/// @brief Copy the viewed region to a vector of vectors
+template <typename T>
+std::vector<std::vector<std::remove_const_t<T>>> MatrixView<T>::ToVector() const
+{
+    std::vector<std::vector<std::remove_const_t<T>>> out;
+    out.reserve(m_rows);
+    for (std::size_t i{0U}; i < m_rows; ++i)
+        out.push_back(Row(i).ToVector());
+    return out;
+}
+
+/// @class TiledView
+/// @brief Read-only view repeating a matrix region in both directions without materializing it: element (row, col)
+///        of the view is element (row % base rows, col % base columns) of the base
+/// @tparam T Type of the viewed elements
+template <typename T>
+class TiledView
+{
+  public:
+    // Constructors
+    TiledView() = default;
+    /// @param base Repeated region (must not be empty)
+    /// @param n_rows Number of rows of the view (any value, not only multiples of the base rows)
+    /// @param n_cols Number of columns of the view
+    TiledView(const MatrixView<const T>& base, const std::size_t n_rows, const std::size_t n_cols)
+        : m_base(base), m_rows(n_rows), m_cols(n_cols)
+    {
+        if (base.NRows() == 0U || base.NCols() == 0U)
+            throw std::length_error("TiledView<T>::TiledView(base, n_rows, n_cols): Base cannot be empty");
+    }
+
+    // Getters
+    inline const MatrixView<const T>& Base() const { return m_base; }
+    inline std::size_t NRows() const { return m_rows; }
+    inline std::size_t NCols() const { return m_cols; }
+    /// @brief Base row repeated by a row of the view (one period of it)
+    inline RowView<const T> BaseRow(const std::size_t row) const { return m_base.Row(row % m_base.NRows()); }
+    std::vector<std::vector<T>> ToVector() const;
+
+    // Operators
+    inline const T& operator()(const std::size_t row, const std::size_t col) const
+    {
+        return m_base(row % m_base.NRows(), col % m_base.NCols());
+    }
+    const T& at(const std::size_t row, const std::size_t col) const
+    {
+        if ((row >= m_rows) || (col >= m_cols)) throw std::out_of_range("TiledView<T>::at(): Index is out of range");
+        return operator()(row, col);
+    }
+
+  private:
+    MatrixView<const T> m_base;
+    std::size_t m_rows{0U};
+    std::size_t m_cols{0U};
+};
+
+/// @brief Materialize the view to a vector of vectors
+template <typename T>
+std::vector<std::vector<T>> TiledView<T>::ToVector() const
+{
+    std::vector<std::vector<T>> out(m_rows);
+    for (std::size_t i{0U}; i < m_rows; ++i)
+    {
+        const RowView<const T> period = BaseRow(i);
+        out[i].reserve(m_cols);
+        for (std::size_t j{0U}; j < m_cols; ++j)
+            out[i].push_back(period[j % period.size()]);
+    }
+    return out;
+}
+
+}  // namespace commonlib
+
+#endif  // DATA_STRUCTURES_MATRIX_VIEW_H
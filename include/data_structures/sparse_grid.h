@@ -0,0 +1,377 @@
+/// @file sparse_grid.h
+/// @author Alberto Santagostino
+
+#ifndef DATA_STRUCTURES_SPARSE_GRID_H
+#define DATA_STRUCTURES_SPARSE_GRID_H
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+
+#ifdef TEST_BUILD
+#include <data_structures/matrix.h>
+#include <data_structures/matrix_view.h>
+#include <utils/simd.h>
+#else
+#include <commonlib/include/data_structures/matrix.h>
+#include <commonlib/include/data_structures/matrix_view.h>
+#include <commonlib/include/utils/simd.h>
+#endif
+
+namespace commonlib
+{
+/// @brief Inclusive bounds of a region of a SparseGrid
+struct BoundingBox
+{
+    long min_row;
+    long min_col;
+    long max_row;
+    long max_col;
+
+    inline std::size_t NRows() const { return std::size_t(max_row - min_row + 1); }
+    inline std::size_t NCols() const { return std::size_t(max_col - min_col + 1); }
+    inline bool Contains(const long row, const long col) const
+    {
+        return (row >= min_row) && (row <= max_row) && (col >= min_col) && (col <= max_col);
+    }
+};
+
+inline bool operator==(const BoundingBox& a, const BoundingBox& b)
+{
+    return (a.min_row == b.min_row) && (a.min_col == b.min_col) && (a.max_row == b.max_row) &&
+           (a.max_col == b.max_col);
+}
+
+/// @class SparseGrid
+/// @brief Unbounded 2D grid: every cell holds the background value until it is set. Cells are stored in square chunks
+///        of ChunkSide x ChunkSide, kept in a hash map and allocated on the first write of a non-background value
+/// @details Coordinates can be negative. Each chunk counts its non-background cells: a chunk going back to all
+///          background is released, counts are O(1) and the scans only visit the allocated chunks. The bounding box
+///          of the non-background cells is cached and recomputed only from the chunks on its border
+/// @tparam T Type of data stored
+/// @tparam ChunkSide Side of a chunk, a power of two
+template <typename T, std::size_t ChunkSide = 32U>
+class SparseGrid
+{
+    static_assert((ChunkSide > 0U) && ((ChunkSide & (ChunkSide - 1U)) == 0U), "ChunkSide must be a power of two");
+
+  public:
+    using value_type = T;
+    static constexpr std::size_t kChunkSide{ChunkSide};
+
+    // Constructors
+    explicit SparseGrid(const T background = T{});
+    SparseGrid(const Matrix<T>& matrix, const T background, const long origin_row = 0, const long origin_col = 0);
+
+    // Access
+    const T& Get(const long row, const long col) const;
+    void Set(const long row, const long col, const T value);
+    inline const T& operator()(const long row, const long col) const { return Get(row, col); }
+    void Clear();
+
+    // Getters
+    inline const T& Background() const { return m_background; }
+    inline std::size_t NChunks() const { return m_chunks.size(); }
+    inline std::size_t NFilled() const { return m_filled; }  ///< Number of non-background cells
+    inline bool Empty() const { return m_filled == 0U; }
+    std::optional<BoundingBox> GetBoundingBox() const;
+
+    // Bulk operations
+    std::size_t CountElements(const T value) const;
+    template <typename F>
+    void ForEachChunk(F&& callback) const;
+    template <typename F>
+    void ForEachFilled(F&& callback) const;
+    Matrix<T> ToMatrix() const;
+    Matrix<T> ToMatrix(const BoundingBox& box) const;
+
+  private:
+    static constexpr long kShift{__builtin_ctzll(ChunkSide)};
+    static constexpr long kMask{long(ChunkSide) - 1};
+    static constexpr std::size_t kChunkCells{ChunkSide * ChunkSide};
+
+    struct Chunk
+    {
+        std::unique_ptr<T[]> cells;
+        std::size_t n_filled{0U};
+    };
+
+    using ChunkKey = std::pair<long, long>;  ///< (chunk row, chunk column)
+    struct ChunkKeyHash
+    {
+        /// @brief Mix of both full coordinates (splitmix64 finalizer), so that distant chunks never share a key
+        inline std::size_t operator()(const ChunkKey& key) const noexcept
+        {
+            std::uint64_t hash{std::uint64_t(key.first) * 0x9e3779b97f4a7c15ULL ^ std::uint64_t(key.second)};
+            hash = (hash ^ (hash >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+            hash = (hash ^ (hash >> 27U)) * 0x94d049bb133111ebULL;
+            return std::size_t(hash ^ (hash >> 31U));
+        }
+    };
+
+    T m_background;
+    std::unordered_map<ChunkKey, Chunk, ChunkKeyHash> m_chunks;
+    std::size_t m_filled{0U};
+    mutable std::optional<BoundingBox> m_box;  ///< Cached bounding box (valid if m_box_valid)
+    mutable bool m_box_valid{true};
+
+    static inline ChunkKey m_Key(const long chunk_row, const long chunk_col) { return ChunkKey(chunk_row, chunk_col); }
+    static inline long m_ChunkRow(const ChunkKey& key) { return key.first; }
+    static inline long m_ChunkCol(const ChunkKey& key) { return key.second; }
+    static inline std::size_t m_Local(const long row, const long col)
+    {
+        return std::size_t(row & kMask) * ChunkSide + std::size_t(col & kMask);
+    }
+    static BoundingBox m_ChunkBox(const ChunkKey& key, const T* cells, const T& background);
+};
+
+/// @brief Constructor: empty grid
+/// @param background Value of every cell not set
+template <typename T, std::size_t ChunkSide>
+SparseGrid<T, ChunkSide>::SparseGrid(const T background) : m_background(background)
+{}
+
+/// @brief Constructor: copy the non-background cells of a matrix
+/// @param origin_row, origin_col Coordinates of the matrix element (0, 0) in the sparse grid
+template <typename T, std::size_t ChunkSide>
+SparseGrid<T, ChunkSide>::SparseGrid(const Matrix<T>& matrix, const T background, const long origin_row,
+                                     const long origin_col)
+    : m_background(background)
+{
+    for (std::size_t row{0U}; row < matrix.NRows(); ++row)
+    {
+        const RowView<const T> values = std::as_const(matrix).Row(row);
+        for (std::size_t col{0U}; col < matrix.NCols(); ++col)
+        {
+            if (!(values[col] == background)) Set(origin_row + long(row), origin_col + long(col), values[col]);
+        }
+    }
+}
+
+/// @brief Value of a cell (the background if it has never been set)
+template <typename T, std::size_t ChunkSide>
+const T& SparseGrid<T, ChunkSide>::Get(const long row, const long col) const
+{
+    const auto it = m_chunks.find(m_Key(row >> kShift, col >> kShift));
+    if (it == m_chunks.end()) return m_background;
+    return it->second.cells[m_Local(row, col)];
+}
+
+/// @brief Set the value of a cell, allocating its chunk if needed (setting the background never allocates)
+template <typename T, std::size_t ChunkSide>
+void SparseGrid<T, ChunkSide>::Set(const long row, const long col, const T value)
+{
+    const bool filling{!(value == m_background)};
+    const ChunkKey key{m_Key(row >> kShift, col >> kShift)};
+    auto it = m_chunks.find(key);
+    if (it == m_chunks.end())
+    {
+        if (!filling) return;
+        Chunk chunk;
+        chunk.cells = std::make_unique<T[]>(kChunkCells);
+        std::fill(chunk.cells.get(), chunk.cells.get() + kChunkCells, m_background);
+        it = m_chunks.emplace(key, std::move(chunk)).first;
+    }
+    Chunk& chunk = it->second;
+    T& cell = chunk.cells[m_Local(row, col)];
+    const bool was_filled{!(cell == m_background)};
+    cell = value;
+    if (filling == was_filled) return;
+
+    if (filling)
+    {
+        ++chunk.n_filled;
+        ++m_filled;
+        // Growing the box never needs a rescan
+        if (m_box_valid)
+        {
+            if (!m_box)
+            {
+                m_box = BoundingBox{row, col, row, col};
+            }
+            else
+            {
+                m_box->min_row = std::min(m_box->min_row, row);
+                m_box->min_col = std::min(m_box->min_col, col);
+                m_box->max_row = std::max(m_box->max_row, row);
+                m_box->max_col = std::max(m_box->max_col, col);
+            }
+        }
+    }
+    else
+    {
+        --chunk.n_filled;
+        --m_filled;
+        if (chunk.n_filled == 0U) m_chunks.erase(it);
+        // Clearing a cell on the border of the box may shrink it
+        if (m_box_valid && m_box &&
+            ((row == m_box->min_row) || (row == m_box->max_row) || (col == m_box->min_col) ||
+             (col == m_box->max_col)))
+            m_box_valid = false;
+    }
+}
+
+/// @brief Reset all cells to the background, releasing all chunks
+template <typename T, std::size_t ChunkSide>
+void SparseGrid<T, ChunkSide>::Clear()
+{
+    m_chunks.clear();
+    m_filled = 0U;
+    m_box.reset();
+    m_box_valid = true;
+}
+
+/// @brief Smallest box containing all non-background cells
+/// @return The box, std::nullopt if the grid is empty
+template <typename T, std::size_t ChunkSide>
+std::optional<BoundingBox> SparseGrid<T, ChunkSide>::GetBoundingBox() const
+{
+    if (m_box_valid) return m_box;
+    m_box_valid = true;
+    m_box.reset();
+    if (m_chunks.empty()) return m_box;
+
+    // Chunk-level bounds first, then only the chunks on the border are scanned
+    long min_chunk_row{m_ChunkRow(m_chunks.begin()->first)};
+    long max_chunk_row{min_chunk_row};
+    long min_chunk_col{m_ChunkCol(m_chunks.begin()->first)};
+    long max_chunk_col{min_chunk_col};
+    for (const auto& [key, chunk] : m_chunks)
+    {
+        min_chunk_row = std::min(min_chunk_row, m_ChunkRow(key));
+        max_chunk_row = std::max(max_chunk_row, m_ChunkRow(key));
+        min_chunk_col = std::min(min_chunk_col, m_ChunkCol(key));
+        max_chunk_col = std::max(max_chunk_col, m_ChunkCol(key));
+    }
+    for (const auto& [key, chunk] : m_chunks)
+    {
+        const long chunk_row{m_ChunkRow(key)};
+        const long chunk_col{m_ChunkCol(key)};
+        if ((chunk_row != min_chunk_row) && (chunk_row != max_chunk_row) && (chunk_col != min_chunk_col) &&
+            (chunk_col != max_chunk_col))
+            continue;
+        const BoundingBox box = m_ChunkBox(key, chunk.cells.get(), m_background);
+        if (!m_box)
+        {
+            m_box = box;
+            continue;
+        }
+        m_box->min_row = std::min(m_box->min_row, box.min_row);
+        m_box->min_col = std::min(m_box->min_col, box.min_col);
+        m_box->max_row = std::max(m_box->max_row, box.max_row);
+        m_box->max_col = std::max(m_box->max_col, box.max_col);
+    }
+    return m_box;
+}
+
+/// @brief Count the cells equal to a value
+/// @details Non-background values are counted in the allocated chunks only (vectorized), the background is counted
+///          inside the bounding box
+template <typename T, std::size_t ChunkSide>
+std::size_t SparseGrid<T, ChunkSide>::CountElements(const T value) const
+{
+    if (value == m_background)
+    {
+        const auto box = GetBoundingBox();
+        return box ? (box->NRows() * box->NCols() - m_filled) : 0U;
+    }
+    std::size_t count{0U};
+    for (const auto& [key, chunk] : m_chunks)
+    {
+        if constexpr (std::is_arithmetic_v<T>)
+            count += simd::Count(chunk.cells.get(), kChunkCells, value);
+        else
+            count += std::size_t(std::count(chunk.cells.get(), chunk.cells.get() + kChunkCells, value));
+    }
+    return count;
+}
+
+/// @brief Call callback(origin_row, origin_col, MatrixView<const T>) for every allocated chunk, in no specific order
+/// @details origin_row/origin_col are the coordinates of the first cell of the chunk
+template <typename T, std::size_t ChunkSide>
+template <typename F>
+void SparseGrid<T, ChunkSide>::ForEachChunk(F&& callback) const
+{
+    for (const auto& [key, chunk] : m_chunks)
+    {
+        callback(m_ChunkRow(key) << kShift, m_ChunkCol(key) << kShift,
+                 MatrixView<const T>(chunk.cells.get(), ChunkSide, ChunkSide, ChunkSide));
+    }
+}
+
+/// @brief Call callback(row, col, value) for every non-background cell, chunk by chunk
+template <typename T, std::size_t ChunkSide>
+template <typename F>
+void SparseGrid<T, ChunkSide>::ForEachFilled(F&& callback) const
+{
+    for (const auto& [key, chunk] : m_chunks)
+    {
+        const long origin_row{m_ChunkRow(key) << kShift};
+        const long origin_col{m_ChunkCol(key) << kShift};
+        for (std::size_t i{0U}; i < kChunkCells; ++i)
+        {
+            if (!(chunk.cells[i] == m_background))
+                callback(origin_row + long(i / ChunkSide), origin_col + long(i % ChunkSide), chunk.cells[i]);
+        }
+    }
+}
+
+/// @brief Dense copy of the bounding box
+/// @throw std::length_error If the grid is empty
+template <typename T, std::size_t ChunkSide>
+Matrix<T> SparseGrid<T, ChunkSide>::ToMatrix() const
+{
+    const auto box = GetBoundingBox();
+    if (!box) throw std::length_error("SparseGrid<T>::ToMatrix(): Grid is empty");
+    return ToMatrix(*box);
+}
+
+/// @brief Dense copy of a region, element (0, 0) is the cell (box.min_row, box.min_col)
+template <typename T, std::size_t ChunkSide>
+Matrix<T> SparseGrid<T, ChunkSide>::ToMatrix(const BoundingBox& box) const
+{
+    Matrix<T> matrix(box.NRows(), box.NCols(), m_background);
+    ForEachChunk([&](const long origin_row, const long origin_col, const MatrixView<const T>& cells) {
+        const long first_row{std::max(origin_row, box.min_row)};
+        const long last_row{std::min(origin_row + long(ChunkSide) - 1, box.max_row)};
+        const long first_col{std::max(origin_col, box.min_col)};
+        const long last_col{std::min(origin_col + long(ChunkSide) - 1, box.max_col)};
+        for (long row{first_row}; row <= last_row; ++row)
+        {
+            for (long col{first_col}; col <= last_col; ++col)
+                matrix(std::size_t(row - box.min_row), std::size_t(col - box.min_col)) =
+                    cells(std::size_t(row - origin_row), std::size_t(col - origin_col));
+        }
+    });
+    return matrix;
+}
+
+/// @brief Bounds of the non-background cells of a (non-empty) chunk
+template <typename T, std::size_t ChunkSide>
+BoundingBox SparseGrid<T, ChunkSide>::m_ChunkBox(const ChunkKey& key, const T* cells, const T& background)
+{
+    const long origin_row{m_ChunkRow(key) << kShift};
+    const long origin_col{m_ChunkCol(key) << kShift};
+    BoundingBox box{long(ChunkSide), long(ChunkSide), -1, -1};
+    for (std::size_t i{0U}; i < kChunkCells; ++i)
+    {
+        if (cells[i] == background) continue;
+        const long row{long(i / ChunkSide)};
+        const long col{long(i % ChunkSide)};
+        box.min_row = std::min(box.min_row, row);
+        box.min_col = std::min(box.min_col, col);
+        box.max_row = std::max(box.max_row, row);
+        box.max_col = std::max(box.max_col, col);
+    }
+    return BoundingBox{origin_row + box.min_row, origin_col + box.min_col, origin_row + box.max_row,
+                       origin_col + box.max_col};
+}
+
+}  // namespace commonlib
+
+#endif  // DATA_STRUCTURES_SPARSE_GRID_H
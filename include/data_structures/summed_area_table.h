@@ -0,0 +1,220 @@
+/// @file summed_area_table.h
+/// @author Alberto Santagostino
+
+#ifndef DATA_STRUCTURES_SUMMED_AREA_TABLE_H
+#define DATA_STRUCTURES_SUMMED_AREA_TABLE_H
+
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#ifdef TEST_BUILD
+#include <data_structures/matrix.h>
+#else
+#include <commonlib/include/data_structures/matrix.h>
+#endif
+
+namespace commonlib
+{
+/// @class SummedAreaTable
+/// @brief Summed-area table of a numeric matrix: the sum of any rectangle in O(1) while no update is pending
+/// @details Updates are O(log rows x log cols): their deltas go to a 2D Fenwick tree, which the queries also read
+///          (O(log rows x log cols)) until the pending updates are folded into the table with one O(rows x cols)
+///          pass, once there are more than PendingLimit() of them. The element values are kept aside, so folding
+///          never recovers them from the prefix sums (no cancellation error for floating-point elements)
+/// @tparam T Type of the elements of the matrix (arithmetic)
+template <typename T>
+class SummedAreaTable
+{
+    static_assert(std::is_arithmetic_v<T>, "SummedAreaTable requires an arithmetic element type");
+
+  public:
+    /// @brief Type of the sums: double for floating-point elements, 64-bit integers otherwise
+    using sum_type = std::conditional_t<std::is_floating_point_v<T>,
+                                        double,
+                                        std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>>;
+
+    // Constructors
+    SummedAreaTable() = default;
+    template <typename BoundsCheck>
+    explicit SummedAreaTable(const Matrix<T, BoundsCheck>& matrix);
+
+    // Setters
+    template <typename BoundsCheck>
+    void Build(const Matrix<T, BoundsCheck>& matrix);
+    void Set(const std::size_t row, const std::size_t col, const T value);
+    void Add(const std::size_t row, const std::size_t col, const sum_type delta);
+    void Flush();
+    inline void SetPendingLimit(const std::size_t limit) { m_pending_limit = limit; }
+
+    // Getters
+    inline std::size_t NRows() const { return m_rows; }
+    inline std::size_t NCols() const { return m_cols; }
+    inline std::size_t PendingLimit() const { return m_pending_limit; }
+    inline std::size_t NPending() const { return m_n_pending; }
+    sum_type Sum(const std::size_t first_row,
+                 const std::size_t first_col,
+                 const std::size_t last_row,
+                 const std::size_t last_col) const;
+    inline sum_type Total() const { return (m_rows == 0U) ? sum_type{} : Sum(0U, 0U, m_rows - 1U, m_cols - 1U); }
+    sum_type At(const std::size_t row, const std::size_t col) const;
+
+  private:
+    std::size_t m_rows{0U};
+    std::size_t m_cols{0U};
+    std::vector<sum_type> m_values;  ///< rows x cols, current element values
+    std::vector<sum_type> m_table;   ///< (rows + 1) x (cols + 1), row 0 and column 0 are zeros
+    std::vector<sum_type> m_tree;    ///< (rows + 1) x (cols + 1) Fenwick tree of the pending deltas, empty if none
+    std::size_t m_n_pending{0U};
+    std::size_t m_pending_limit{64U};
+
+    inline sum_type m_Prefix(const std::size_t row, const std::size_t col) const
+    {
+        return m_table[row * (m_cols + 1U) + col];
+    }
+    void m_AddPending(const std::size_t row, const std::size_t col, const sum_type delta);
+    sum_type m_PendingPrefix(const std::size_t row, const std::size_t col) const;
+    void m_Accumulate();
+};
+
+/// @brief Constructor: build the table of a matrix
+template <typename T>
+template <typename BoundsCheck>
+SummedAreaTable<T>::SummedAreaTable(const Matrix<T, BoundsCheck>& matrix)
+{
+    Build(matrix);
+}
+
+/// @brief (Re)build the table of a matrix, dropping the pending updates
+/// @details The pending limit is reset to a sixteenth of the number of elements (at least 64): folding then costs
+///          O(1) amortized Fenwick-sized work per update
+template <typename T>
+template <typename BoundsCheck>
+void SummedAreaTable<T>::Build(const Matrix<T, BoundsCheck>& matrix)
+{
+    m_rows = matrix.NRows();
+    m_cols = matrix.NCols();
+    m_values.resize(m_rows * m_cols);
+    for (std::size_t row{0U}; row < m_rows; ++row)
+    {
+        const T* src = matrix[row];
+        for (std::size_t col{0U}; col < m_cols; ++col)
+            m_values[row * m_cols + col] = static_cast<sum_type>(src[col]);
+    }
+    m_Accumulate();
+    m_tree.clear();
+    m_n_pending = 0U;
+    m_pending_limit = std::max<std::size_t>(64U, m_rows * m_cols / 16U);
+}
+
+/// @brief Record that an element of the matrix has been set to a new value
+/// @throw std::out_of_range If the element does not exist
+template <typename T>
+void SummedAreaTable<T>::Set(const std::size_t row, const std::size_t col, const T value)
+{
+    const sum_type old_value{At(row, col)};
+    m_values[row * m_cols + col] = static_cast<sum_type>(value);
+    m_AddPending(row, col, static_cast<sum_type>(value) - old_value);
+}
+
+/// @brief Current value of an element, in O(1)
+/// @throw std::out_of_range If the element does not exist
+template <typename T>
+typename SummedAreaTable<T>::sum_type SummedAreaTable<T>::At(const std::size_t row, const std::size_t col) const
+{
+    if ((row >= m_rows) || (col >= m_cols))
+        throw std::out_of_range("SummedAreaTable<T>::At(row, col): Index is out of range");
+    return m_values[row * m_cols + col];
+}
+
+/// @brief Record that an element of the matrix has been increased by delta
+/// @throw std::out_of_range If the element does not exist
+template <typename T>
+void SummedAreaTable<T>::Add(const std::size_t row, const std::size_t col, const sum_type delta)
+{
+    if ((row >= m_rows) || (col >= m_cols))
+        throw std::out_of_range("SummedAreaTable<T>::Add(row, col, delta): Index is out of range");
+    m_values[row * m_cols + col] += delta;
+    m_AddPending(row, col, delta);
+}
+
+/// @brief Fold the pending updates into the table (one pass over the table)
+template <typename T>
+void SummedAreaTable<T>::Flush()
+{
+    if (m_n_pending == 0U) return;
+    m_Accumulate();
+    m_tree.clear();
+    m_n_pending = 0U;
+}
+
+/// @brief Sum of the elements of a rectangle (bounds included, clamped to the matrix)
+/// @return The sum, 0 if the rectangle is empty
+template <typename T>
+typename SummedAreaTable<T>::sum_type SummedAreaTable<T>::Sum(const std::size_t first_row,
+                                                              const std::size_t first_col,
+                                                              const std::size_t last_row,
+                                                              const std::size_t last_col) const
+{
+    if ((m_rows == 0U) || (m_cols == 0U)) return sum_type{};
+    const std::size_t end_row{std::min(last_row, m_rows - 1U) + 1U};
+    const std::size_t end_col{std::min(last_col, m_cols - 1U) + 1U};
+    if ((first_row >= end_row) || (first_col >= end_col)) return sum_type{};
+    sum_type sum{m_Prefix(end_row, end_col) - m_Prefix(first_row, end_col) - m_Prefix(end_row, first_col) +
+                 m_Prefix(first_row, first_col)};
+    if (m_n_pending > 0U)
+    {
+        sum += m_PendingPrefix(end_row, end_col) - m_PendingPrefix(first_row, end_col) -
+               m_PendingPrefix(end_row, first_col) + m_PendingPrefix(first_row, first_col);
+    }
+    return sum;
+}
+
+/// @brief Add a delta to the Fenwick tree of the pending updates, folding them if there are too many
+template <typename T>
+void SummedAreaTable<T>::m_AddPending(const std::size_t row, const std::size_t col, const sum_type delta)
+{
+    if (m_tree.empty()) m_tree.assign((m_rows + 1U) * (m_cols + 1U), sum_type{});
+    const std::size_t stride{m_cols + 1U};
+    for (std::size_t i{row + 1U}; i <= m_rows; i += i & (~i + 1U))
+        for (std::size_t j{col + 1U}; j <= m_cols; j += j & (~j + 1U))
+            m_tree[i * stride + j] += delta;
+    if (++m_n_pending > m_pending_limit) Flush();
+}
+
+/// @brief Sum of the pending deltas of the elements above row and left of col (Fenwick tree prefix query)
+template <typename T>
+typename SummedAreaTable<T>::sum_type SummedAreaTable<T>::m_PendingPrefix(const std::size_t row,
+                                                                          const std::size_t col) const
+{
+    const std::size_t stride{m_cols + 1U};
+    sum_type sum{};
+    for (std::size_t i{row}; i > 0U; i &= i - 1U)
+        for (std::size_t j{col}; j > 0U; j &= j - 1U)
+            sum += m_tree[i * stride + j];
+    return sum;
+}
+
+/// @brief Compute the prefix sums of the element values
+template <typename T>
+void SummedAreaTable<T>::m_Accumulate()
+{
+    const std::size_t stride{m_cols + 1U};
+    m_table.assign((m_rows + 1U) * stride, sum_type{});
+    for (std::size_t row{1U}; row <= m_rows; ++row)
+    {
+        const sum_type* values = m_values.data() + (row - 1U) * m_cols;
+        sum_type row_sum{};
+        for (std::size_t col{1U}; col <= m_cols; ++col)
+        {
+            row_sum += values[col - 1U];
+            m_table[row * stride + col] = row_sum + m_table[(row - 1U) * stride + col];
+        }
+    }
+}
+
+}  // namespace commonlib
+
+#endif  // DATA_STRUCTURES_SUMMED_AREA_TABLE_H
@@ -0,0 +1,227 @@
+/// @file delimited_scanner.h
+/// @author Alberto Santagostino
+
+#ifndef IO_DELIMITED_SCANNER_H
+#define IO_DELIMITED_SCANNER_H
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+namespace commonlib
+{
+/// @class ParseError
+/// @brief Error raised when a cell of a text matrix cannot be parsed. Row and column are the (0-based) indices the
+///        cell would have had in the matrix
+class ParseError : public std::runtime_error
+{
+  public:
+    ParseError(const std::string& what, const std::size_t row, const std::size_t col)
+        : std::runtime_error(what + ": Malformed cell at row " + std::to_string(row) + ", column " +
+                             std::to_string(col)),
+          m_row(row),
+          m_col(col)
+    {}
+    inline std::size_t Row() const { return m_row; }
+    inline std::size_t Column() const { return m_col; }
+
+  private:
+    std::size_t m_row;
+    std::size_t m_col;
+};
+
+namespace detail
+{
+/// @brief Bitmask of the bytes in [ptr, ptr + 64) equal to a or b (bit i set if ptr[i] matches)
+inline std::uint64_t MatchMask64(const char* ptr, const char a, const char b)
+{
+#if defined(__AVX2__)
+    const __m256i va = _mm256_set1_epi8(a);
+    const __m256i vb = _mm256_set1_epi8(b);
+    const __m256i lo = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr));
+    const __m256i hi = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ptr + 32));
+    const std::uint32_t mask_lo = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(lo, va), _mm256_cmpeq_epi8(lo, vb))));
+    const std::uint32_t mask_hi = static_cast<std::uint32_t>(
+        _mm256_movemask_epi8(_mm256_or_si256(_mm256_cmpeq_epi8(hi, va), _mm256_cmpeq_epi8(hi, vb))));
+    return (static_cast<std::uint64_t>(mask_hi) << 32) | mask_lo;
+#elif defined(__SSE2__)
+    const __m128i va = _mm_set1_epi8(a);
+    const __m128i vb = _mm_set1_epi8(b);
+    std::uint64_t mask{0U};
+    for (int i{0}; i < 4; ++i)
+    {
+        const __m128i chunk = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ptr + 16 * i));
+        const std::uint64_t bits = static_cast<std::uint16_t>(
+            _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(chunk, va), _mm_cmpeq_epi8(chunk, vb))));
+        mask |= bits << (16 * i);
+    }
+    return mask;
+#else
+    std::uint64_t mask{0U};
+    for (int i{0}; i < 64; ++i)
+    {
+        mask |= static_cast<std::uint64_t>((ptr[i] == a) || (ptr[i] == b)) << i;
+    }
+    return mask;
+#endif
+}
+
+/// @brief Index of the lowest set bit of a non-zero mask
+inline unsigned LowestBit(const std::uint64_t mask)
+{
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+}
+
+}  // namespace detail
+
+/// @brief Count the occurrences of a character in [begin, end)
+inline std::size_t CountChar(const char* begin, const char* end, const char c)
+{
+    std::size_t count{0U};
+    const char* ptr = begin;
+    for (; ptr + 64 <= end; ptr += 64)
+    {
+        count += static_cast<std::size_t>(__builtin_popcountll(detail::MatchMask64(ptr, c, c)));
+    }
+    for (; ptr < end; ++ptr)
+    {
+        count += (*ptr == c) ? 1U : 0U;
+    }
+    return count;
+}
+
+/// @brief Scan a delimited text (cells separated by sep, rows by '\n'), locating the delimiters 64 bytes at a time
+/// @details Empty lines are skipped and a '\r' before a newline is dropped. For every cell on_cell(begin, end) is
+///          called with the cell bytes, then on_row_end() is called at the end of every non-empty line
+/// @param sep Separator between the cells of a row
+template <typename OnCell, typename OnRowEnd>
+void ScanDelimited(const char* begin, const char* end, const char sep, OnCell&& on_cell, OnRowEnd&& on_row_end)
+{
+    const char* tok = begin;
+    bool row_open{false};
+    auto on_delimiter = [&](const char* delim) {
+        if (*delim == sep)
+        {
+            on_cell(tok, delim);
+            row_open = true;
+        }
+        else
+        {
+            const char* tok_end = ((delim > tok) && (delim[-1] == '\r')) ? (delim - 1) : delim;
+            if (row_open || (tok_end > tok))
+            {
+                on_cell(tok, tok_end);
+                on_row_end();
+            }
+            row_open = false;
+        }
+        tok = delim + 1;
+    };
+
+    const char* ptr = begin;
+    for (; ptr + 64 <= end; ptr += 64)
+    {
+        std::uint64_t mask = detail::MatchMask64(ptr, sep, '\n');
+        while (mask != 0U)
+        {
+            on_delimiter(ptr + detail::LowestBit(mask));
+            mask &= mask - 1U;
+        }
+    }
+    for (; ptr < end; ++ptr)
+    {
+        if ((*ptr == sep) || (*ptr == '\n')) on_delimiter(ptr);
+    }
+
+    // Last row, not terminated by a newline
+    const char* tok_end = ((end > tok) && (end[-1] == '\r')) ? (end - 1) : end;
+    if (row_open || (tok_end > tok))
+    {
+        on_cell(tok, tok_end);
+        on_row_end();
+    }
+}
+
+/// @brief Parse a numeric cell (surrounding blanks are ignored)
+/// @return false if the cell is not entirely made of a valid value of type T
+template <typename T>
+bool ParseCell(const char* begin, const char* end, T& value)
+{
+    while ((begin < end) && ((*begin == ' ') || (*begin == '\t')))
+        ++begin;
+    while ((end > begin) && ((end[-1] == ' ') || (end[-1] == '\t')))
+        --end;
+    const auto [ptr, ec] = std::from_chars(begin, end, value);
+    return (ec == std::errc()) && (ptr == end) && (begin < end);
+}
+
+/// @brief Parse the non-empty lines of [begin, end) (which must start at the beginning of a line) as rows of n_cols
+///        elements, row r being written at out + r * row_stride
+/// @param sep Separator between the elements ('\0' if every character is an element)
+/// @param first_row Index of the first parsed row, used in the errors
+/// @param what Prefix of the error messages
+/// @return Number of parsed rows
+/// @throw std::length_error If a row does not have n_cols elements
+/// @throw commonlib::ParseError If a cell does not hold a valid value of type T
+template <typename T>
+std::size_t ParseRows(const char* begin,
+                      const char* end,
+                      const char sep,
+                      T* out,
+                      const std::size_t n_cols,
+                      const std::size_t row_stride,
+                      const std::size_t first_row,
+                      const char* what)
+{
+    std::size_t row{0U};
+    if (sep == '\0')
+    {
+        for (const char* line = begin; line < end;)
+        {
+            const void* found = std::memchr(line, '\n', static_cast<std::size_t>(end - line));
+            const char* newline = (found == nullptr) ? end : static_cast<const char*>(found);
+            const char* line_end = ((newline > line) && (newline[-1] == '\r')) ? (newline - 1) : newline;
+            if (line_end > line)
+            {
+                if (static_cast<std::size_t>(line_end - line) != n_cols)
+                    throw std::length_error(std::string(what) + ": Size not coherent, all rows must have the same length");
+                std::copy(line, line_end, out + (row++) * row_stride);
+            }
+            line = newline + 1;
+        }
+        return row;
+    }
+
+    std::size_t col{0U};
+    T* cells = out;
+    ScanDelimited(
+        begin,
+        end,
+        sep,
+        [&](const char* tok, const char* tok_end) {
+            if (col >= n_cols)
+                throw std::length_error(std::string(what) + ": Size not coherent, all rows must have the same length");
+            if (!ParseCell(tok, tok_end, cells[col])) throw ParseError(what, first_row + row, col);
+            ++col;
+        },
+        [&]() {
+            if (col != n_cols)
+                throw std::length_error(std::string(what) + ": Size not coherent, all rows must have the same length");
+            col = 0U;
+            cells = out + (++row) * row_stride;
+        });
+    return row;
+}
+
+}  // namespace commonlib
+
+#endif  // IO_DELIMITED_SCANNER_H
@@ -0,0 +1,111 @@
+/// @file mapped_file.h
+/// @author Alberto Santagostino
+
+#ifndef IO_MAPPED_FILE_H
+#define IO_MAPPED_FILE_H
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ios>
+#include <string>
+#include <string_view>
+
+namespace commonlib
+{
+/// @class MappedFile
+/// @brief Read-only file mapped in memory (POSIX mmap). Pages are private copy-on-write: writing to them never
+///        modifies the file on disk, which allows structures to borrow the mapped bytes as mutable storage
+class MappedFile
+{
+  public:
+    // Constructors
+    explicit MappedFile(const std::string& path);
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    ~MappedFile();
+
+    // Getters
+    inline char* Data() { return m_data; }
+    inline const char* Data() const { return m_data; }
+    inline std::size_t Size() const { return m_size; }
+    inline std::string_view View() const { return std::string_view(m_data, m_size); }
+
+  private:
+    char* m_data{nullptr};
+    std::size_t m_size{0U};
+
+    void m_Unmap();
+};
+
+/// @brief Constructor: map the whole file in memory
+/// @param path Path of the file to map
+/// @throw std::ios_base::failure If the file cannot be opened or mapped
+inline MappedFile::MappedFile(const std::string& path)
+{
+    const int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        throw std::ios_base::failure("MappedFile::MappedFile(path): File not found");
+    }
+    struct stat st;
+    if (::fstat(fd, &st) != 0)
+    {
+        ::close(fd);
+        throw std::ios_base::failure("MappedFile::MappedFile(path): Cannot read file size");
+    }
+    m_size = static_cast<std::size_t>(st.st_size);
+    if (m_size > 0U)
+    {
+        void* addr = ::mmap(nullptr, m_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED)
+        {
+            ::close(fd);
+            throw std::ios_base::failure("MappedFile::MappedFile(path): Cannot map file");
+        }
+        ::madvise(addr, m_size, MADV_SEQUENTIAL);
+        m_data = static_cast<char*>(addr);
+    }
+    ::close(fd);
+}
+
+inline MappedFile::MappedFile(MappedFile&& other) noexcept : m_data(other.m_data), m_size(other.m_size)
+{
+    other.m_data = nullptr;
+    other.m_size = 0U;
+}
+
+inline MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+{
+    if (this != &other)
+    {
+        m_Unmap();
+        m_data = other.m_data;
+        m_size = other.m_size;
+        other.m_data = nullptr;
+        other.m_size = 0U;
+    }
+    return *this;
+}
+
+inline MappedFile::~MappedFile()
+{
+    m_Unmap();
+}
+
+inline void MappedFile::m_Unmap()
+{
+    if (m_data != nullptr)
+    {
+        ::munmap(m_data, m_size);
+        m_data = nullptr;
+    }
+}
+
+}  // namespace commonlib
+
+#endif  // IO_MAPPED_FILE_H
@@ -0,0 +1,209 @@
+/// @file row_reader.h
+/// @author Alberto Santagostino
+
+#ifndef IO_ROW_READER_H
+#define IO_ROW_READER_H
+
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef TEST_BUILD
+#include <data_structures/matrix.h>
+#include <io/delimited_scanner.h>
+#else
+#include <commonlib/include/data_structures/matrix.h>
+#include <commonlib/include/io/delimited_scanner.h>
+#endif
+
+namespace commonlib
+{
+/// @class MatrixRowReader
+/// @brief Streaming reader of a text matrix (same formats as the Matrix(fp, row_sep) constructor), for matrices
+///        that do not fit in memory. Rows are parsed in place from a fixed-size text chunk into a reused block, so
+///        the memory used is bounded by the chunk size and by the block (or window) height, whatever the number of
+///        rows of the file
+/// @tparam T Type of the elements
+template <typename T>
+class MatrixRowReader
+{
+  public:
+    static constexpr std::size_t kDefaultChunkSize{std::size_t{1} << 20U};
+
+    explicit MatrixRowReader(std::istream& fp, const char row_sep = ',', const std::size_t chunk_size = kDefaultChunkSize);
+
+    // Getters
+    inline std::size_t NCols() const { return m_cols; }
+    inline std::size_t RowsRead() const { return m_rows_read; }
+
+    // Streaming
+    std::size_t Read(Matrix<T>& block);
+    template <typename F>
+    std::size_t ForEachBlock(const std::size_t block_rows, F&& fn);
+    template <typename F>
+    std::size_t ForEachWindow(const std::size_t height, F&& fn);
+
+  private:
+    std::istream& m_fp;
+    char m_sep;
+    std::size_t m_chunk_size;
+    std::string m_text;    ///< Text read but not parsed yet starts at m_pos
+    std::size_t m_pos{0U};
+    bool m_eof{false};
+    std::size_t m_cols{0U};
+    std::size_t m_rows_read{0U};
+
+    bool m_FillText();
+    std::size_t m_ParseInto(T* out, const std::size_t row_stride, const std::size_t max_rows);
+};
+
+/// @brief Constructor: read the first row to know the number of columns
+/// @param fp Input stream, read sequentially from its current position
+/// @param row_sep The separator used in the file between elements (use '\0' if there is no separator)
+/// @param chunk_size Number of bytes read from the stream at a time (lines longer than that are still read whole)
+/// @throw std::length_error If the stream holds no row or if chunk_size is 0
+template <typename T>
+MatrixRowReader<T>::MatrixRowReader(std::istream& fp, const char row_sep, const std::size_t chunk_size)
+    : m_fp(fp), m_sep(row_sep), m_chunk_size(chunk_size)
+{
+    if (chunk_size == 0U) throw std::length_error("MatrixRowReader<T>::MatrixRowReader(fp): Chunk size cannot be 0");
+    while (m_FillText())
+    {
+        const char* line = m_text.data() + m_pos;
+        const char* end = m_text.data() + m_text.size();
+        const void* found = std::memchr(line, '\n', static_cast<std::size_t>(end - line));
+        const char* newline = (found == nullptr) ? end : static_cast<const char*>(found);
+        const char* line_end = ((newline > line) && (newline[-1] == '\r')) ? (newline - 1) : newline;
+        if (line_end > line)
+        {
+            m_cols = (row_sep == '\0') ? static_cast<std::size_t>(line_end - line)
+                                       : CountChar(line, line_end, row_sep) + 1U;
+            return;
+        }
+        // Skip the empty lines before the first row
+        m_pos = (newline == end) ? m_text.size() : static_cast<std::size_t>(newline + 1 - m_text.data());
+    }
+    throw std::length_error("MatrixRowReader<T>::MatrixRowReader(fp): Dimensions cannot be 0");
+}
+
+/// @brief Read the next rows into a block
+/// @param block Destination, with NCols() columns: its rows are overwritten from the first one
+/// @return Number of rows read (lower than block.NRows() only at the end of the stream, 0 once it is exhausted)
+/// @throw std::length_error If the block does not have NCols() columns or a row has a different number of elements
+/// @throw commonlib::ParseError If a cell does not hold a valid value of type T
+template <typename T>
+std::size_t MatrixRowReader<T>::Read(Matrix<T>& block)
+{
+    if (block.NCols() != m_cols)
+        throw std::length_error("MatrixRowReader<T>::Read(block): The block must have NCols() columns");
+    return m_ParseInto(block.data(), block.RowStride(), block.NRows());
+}
+
+/// @brief Call fn(first_row, block) on consecutive blocks of rows, until the end of the stream
+/// @param block_rows Number of rows of the blocks (the last one can be shorter)
+/// @param fn Callable taking the index of the first row of the block and a MatrixView<const T> of the block
+/// @return Number of rows read
+/// @throw std::length_error If block_rows is 0
+template <typename T>
+template <typename F>
+std::size_t MatrixRowReader<T>::ForEachBlock(const std::size_t block_rows, F&& fn)
+{
+    if (block_rows == 0U) throw std::length_error("MatrixRowReader<T>::ForEachBlock(block_rows, fn): Blocks cannot be empty");
+    Matrix<T> block(block_rows, m_cols);
+    std::size_t total{0U};
+    for (std::size_t n_rows = Read(block); n_rows > 0U; n_rows = Read(block))
+    {
+        fn(m_rows_read - n_rows, std::as_const(block).SubView(0U, 0U, n_rows, m_cols));
+        total += n_rows;
+    }
+    return total;
+}
+
+/// @brief Call fn(first_row, window) on every window of height consecutive rows (sliding by one row), until the
+///        end of the stream. The rows are read in batches into a buffer of 2 * height rows, so that every row is
+///        parsed once and moved at most once
+/// @param height Number of rows of the windows
+/// @param fn Callable taking the index of the first row of the window and a MatrixView<const T> of the window
+/// @return Number of windows (0 if the stream holds less than height rows)
+/// @throw std::length_error If height is 0
+template <typename T>
+template <typename F>
+std::size_t MatrixRowReader<T>::ForEachWindow(const std::size_t height, F&& fn)
+{
+    if (height == 0U) throw std::length_error("MatrixRowReader<T>::ForEachWindow(height, fn): Windows cannot be empty");
+    Matrix<T> buffer(2U * height, m_cols);
+    std::size_t first_row{m_rows_read};  // Row of the file stored in the first row of the buffer
+    std::size_t start{0U};
+    std::size_t filled{0U};
+    std::size_t n_windows{0U};
+    while (true)
+    {
+        if (filled == buffer.NRows())
+        {
+            std::move(buffer.data() + start * m_cols, buffer.data() + filled * m_cols, buffer.data());
+            first_row += start;
+            filled -= start;
+            start = 0U;
+        }
+        const std::size_t n_rows{m_ParseInto(buffer.data() + filled * m_cols, m_cols, buffer.NRows() - filled)};
+        if (n_rows == 0U) break;
+        filled += n_rows;
+        for (; filled - start >= height; ++start, ++n_windows)
+            fn(first_row + start, std::as_const(buffer).SubView(start, 0U, height, m_cols));
+    }
+    return n_windows;
+}
+
+/// @brief Make sure the unparsed text holds a complete line (or the end of the stream), reading chunks as needed
+/// @return false if there is nothing left to parse
+template <typename T>
+bool MatrixRowReader<T>::m_FillText()
+{
+    while (!m_eof && (m_text.find('\n', m_pos) == std::string::npos))
+    {
+        m_text.erase(0U, m_pos);
+        m_pos = 0U;
+        const std::size_t size{m_text.size()};
+        m_text.resize(size + m_chunk_size);
+        m_fp.read(m_text.data() + size, static_cast<std::streamsize>(m_chunk_size));
+        m_text.resize(size + static_cast<std::size_t>(m_fp.gcount()));
+        m_eof = !m_fp;
+    }
+    return m_pos < m_text.size();
+}
+
+/// @brief Parse up to max_rows rows, row r being written at out + r * row_stride
+/// @return Number of rows parsed
+template <typename T>
+std::size_t MatrixRowReader<T>::m_ParseInto(T* out, const std::size_t row_stride, const std::size_t max_rows)
+{
+    std::size_t n_rows{0U};
+    while ((n_rows < max_rows) && m_FillText())
+    {
+        // Parse the complete lines available, up to the missing number of rows
+        const char* begin = m_text.data() + m_pos;
+        const char* end = m_eof ? (m_text.data() + m_text.size()) : (m_text.data() + m_text.rfind('\n') + 1);
+        const char* cut = begin;
+        for (std::size_t n_lines{0U}; (cut < end) && (n_lines < max_rows - n_rows);)
+        {
+            const void* found = std::memchr(cut, '\n', static_cast<std::size_t>(end - cut));
+            const char* newline = (found == nullptr) ? end : static_cast<const char*>(found);
+            const char* line_end = ((newline > cut) && (newline[-1] == '\r')) ? (newline - 1) : newline;
+            if (line_end > cut) ++n_lines;
+            cut = (newline == end) ? end : (newline + 1);
+        }
+        const std::size_t parsed{ParseRows(begin, cut, m_sep, out + n_rows * row_stride, m_cols, row_stride,
+                                           m_rows_read, "MatrixRowReader<T>::Read(block)")};
+        m_pos += static_cast<std::size_t>(cut - begin);
+        m_rows_read += parsed;
+        n_rows += parsed;
+    }
+    return n_rows;
+}
+
+}  // namespace commonlib
+
+#endif  // IO_ROW_READER_H
@@ -0,0 +1,190 @@
+/// @file snapshot.h
+/// @author Alberto Santagostino
+
+#ifndef IO_SNAPSHOT_H
+#define IO_SNAPSHOT_H
+
+#include <cstdint>
+#include <cstring>
+#include <ios>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+
+namespace commonlib
+{
+/// @brief Kind of structure stored in a snapshot
+enum class SnapshotKind : std::uint8_t
+{
+    kSnapshotKind_Matrix = 1U,
+    kSnapshotKind_Grid = 2U
+};
+
+/// @struct SnapshotHeader
+/// @brief Fixed 64-byte header of a binary snapshot. The elements follow the header row-major and unpadded, then
+///        come the kind-specific metadata; the checksum covers everything after the header. Multi-byte fields and
+///        elements are stored in the byte order of the writer, recorded by byte_order
+struct SnapshotHeader
+{
+    char magic[8];
+    std::uint16_t version;
+    SnapshotKind kind;
+    std::uint8_t reserved;
+    std::uint32_t byte_order;  ///< kSnapshotByteOrder as written by the writer
+    std::uint32_t type_tag;    ///< SnapshotTypeTag<T>() of the elements
+    std::uint32_t padding;
+    std::uint64_t n_rows;
+    std::uint64_t n_cols;
+    std::uint64_t data_size;      ///< Size in bytes of the elements
+    std::uint64_t metadata_size;  ///< Size in bytes of the metadata following the elements
+    std::uint64_t checksum;
+};
+static_assert(sizeof(SnapshotHeader) == 64U, "SnapshotHeader must be 64 bytes");
+static_assert(std::is_trivially_copyable_v<SnapshotHeader>, "SnapshotHeader must be trivially copyable");
+
+inline constexpr char kSnapshotMagic[8]{'C', 'L', 'S', 'N', 'A', 'P', '\0', '\0'};
+inline constexpr std::uint16_t kSnapshotVersion{1U};
+inline constexpr std::uint32_t kSnapshotByteOrder{0x01020304U};
+
+/// @brief Tag identifying the element type of a snapshot: category of the type in the high half, size in the low
+template <typename T>
+constexpr std::uint32_t SnapshotTypeTag()
+{
+    static_assert(std::is_trivially_copyable_v<T>, "Snapshots require a trivially copyable element type");
+    std::uint32_t category{5U};
+    if constexpr (std::is_same_v<T, bool>)
+        category = 1U;
+    else if constexpr (std::is_same_v<T, char>)
+        category = 2U;
+    else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+        category = 3U;
+    else if constexpr (std::is_integral_v<T>)
+        category = 4U;
+    else if constexpr (std::is_floating_point_v<T>)
+        category = 6U;
+    return (category << 16U) | static_cast<std::uint32_t>(sizeof(T));
+}
+
+/// @class SnapshotHasher
+/// @brief Incremental 64-bit checksum consuming 8 bytes per step. The digest does not depend on how the input is
+///        split across Update() calls
+class SnapshotHasher
+{
+  public:
+    inline void Update(const void* data, std::size_t size)
+    {
+        const unsigned char* bytes = static_cast<const unsigned char*>(data);
+        while ((m_pending > 0U) && (size > 0U))
+        {
+            m_word[m_pending++] = *bytes++;
+            --size;
+            if (m_pending == 8U) m_Flush();
+        }
+        for (; size >= 8U; size -= 8U, bytes += 8U)
+        {
+            std::uint64_t word;
+            std::memcpy(&word, bytes, 8U);
+            m_Mix(word);
+        }
+        for (; size > 0U; --size) m_word[m_pending++] = *bytes++;
+    }
+    inline std::uint64_t Digest() const
+    {
+        SnapshotHasher copy{*this};
+        if (copy.m_pending > 0U)
+        {
+            std::memset(copy.m_word + copy.m_pending, 0, 8U - copy.m_pending);
+            copy.m_Flush();
+        }
+        copy.m_Mix(copy.m_length);
+        return copy.m_hash;
+    }
+
+  private:
+    std::uint64_t m_hash{0xCBF29CE484222325ULL};
+    std::uint64_t m_length{0U};
+    unsigned char m_word[8]{};
+    std::size_t m_pending{0U};
+
+    inline void m_Mix(const std::uint64_t word)
+    {
+        m_hash = (m_hash ^ word) * 0x100000001B3ULL;
+        m_hash ^= m_hash >> 29U;
+        m_length += 8U;
+    }
+    inline void m_Flush()
+    {
+        std::uint64_t word;
+        std::memcpy(&word, m_word, 8U);
+        m_Mix(word);
+        m_pending = 0U;
+    }
+};
+
+/// @brief Build the header of a snapshot (the checksum is left to the caller)
+template <typename T>
+SnapshotHeader MakeSnapshotHeader(const SnapshotKind kind,
+                                  const std::size_t n_rows,
+                                  const std::size_t n_cols,
+                                  const std::size_t metadata_size)
+{
+    SnapshotHeader header{};
+    std::memcpy(header.magic, kSnapshotMagic, sizeof(header.magic));
+    header.version = kSnapshotVersion;
+    header.kind = kind;
+    header.byte_order = kSnapshotByteOrder;
+    header.type_tag = SnapshotTypeTag<T>();
+    header.n_rows = n_rows;
+    header.n_cols = n_cols;
+    header.data_size = n_rows * n_cols * sizeof(T);
+    header.metadata_size = metadata_size;
+    return header;
+}
+
+/// @brief Validate the snapshot stored in [data, data + size), in place
+/// @param data First byte of the snapshot (e.g. of a mapped file)
+/// @param size Size in bytes of the snapshot
+/// @param type_tag Expected SnapshotTypeTag of the elements
+/// @param verify_checksum Whether to check the checksum as well (one pass over the bytes)
+/// @return The header of the snapshot
+/// @throw std::invalid_argument If the bytes are not a snapshot of the expected type, written with the same byte
+///        order, or if they are truncated or corrupted
+/// @throw std::length_error If the recorded dimensions are 0, which no matrix can have
+inline SnapshotHeader ReadSnapshotHeader(const char* data,
+                                         const std::size_t size,
+                                         const std::uint32_t type_tag,
+                                         const bool verify_checksum = true)
+{
+    SnapshotHeader header;
+    if ((data == nullptr) || (size < sizeof(header)))
+        throw std::invalid_argument("ReadSnapshotHeader(data, size): Truncated snapshot");
+    std::memcpy(&header, data, sizeof(header));
+    if (std::memcmp(header.magic, kSnapshotMagic, sizeof(header.magic)) != 0)
+        throw std::invalid_argument("ReadSnapshotHeader(data, size): Not a snapshot");
+    if (header.byte_order != kSnapshotByteOrder)
+        throw std::invalid_argument("ReadSnapshotHeader(data, size): Snapshot written with a different byte order");
+    if (header.version != kSnapshotVersion)
+        throw std::invalid_argument("ReadSnapshotHeader(data, size): Unsupported snapshot version");
+    if (header.type_tag != type_tag)
+        throw std::invalid_argument("ReadSnapshotHeader(data, size): Snapshot holds a different element type");
+    if ((header.n_rows == 0U) || (header.n_cols == 0U))
+        throw std::length_error("ReadSnapshotHeader(data, size): Dimensions cannot be 0");
+    const std::uint64_t element_size{type_tag & 0xFFFFU};
+    if (header.n_rows > header.data_size / header.n_cols / element_size)
+        throw std::invalid_argument("ReadSnapshotHeader(data, size): Inconsistent dimensions");
+    if ((header.data_size != header.n_rows * header.n_cols * element_size) ||
+        (header.data_size > size - sizeof(header)) || (header.metadata_size != size - sizeof(header) - header.data_size))
+        throw std::invalid_argument("ReadSnapshotHeader(data, size): Truncated snapshot");
+    if (verify_checksum)
+    {
+        SnapshotHasher hasher;
+        hasher.Update(data + sizeof(header), size - sizeof(header));
+        if (hasher.Digest() != header.checksum)
+            throw std::invalid_argument("ReadSnapshotHeader(data, size): Checksum mismatch");
+    }
+    return header;
+}
+
+}  // namespace commonlib
+
+#endif  // IO_SNAPSHOT_H
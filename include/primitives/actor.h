@@ -21,13 +21,17 @@ class Actor
     Actor();
     Actor(const std::size_t id);
     Actor(const std::size_t id, unsigned char character);
+    Actor(const std::size_t id, unsigned char character, const Position<std::size_t> position);
+    Actor(const Actor& other) = default;
 
     // Setters
     inline void SetCharacter(char character) { m_character = character; }
+    inline void SetPosition(const Position<std::size_t> position) { m_position = position; }
 
     // Getters
-    inline const unsigned char GetCharacter() { return m_character; }
-    inline const std::size_t Id() { return m_id; }
+    inline unsigned char GetCharacter() const { return m_character; }
+    inline std::size_t Id() const { return m_id; }
+    inline const Position<std::size_t>& GetPosition() const { return m_position; }
 
     // Operators
     Actor& operator=(const Actor& other);
@@ -35,22 +39,27 @@ class Actor
   private:
     char m_character;
     std::size_t m_id;
-    // TODO: Add Position
+    Position<std::size_t> m_position;  ///< x = column, y = row
 };
 
-Actor::Actor()
+inline Actor::Actor()
 {}
 
-Actor::Actor(std::size_t id) : m_id(id)
+inline Actor::Actor(std::size_t id) : m_id(id)
 {}
 
-Actor::Actor(std::size_t id, unsigned char character) : m_id(id), m_character(character)
+inline Actor::Actor(std::size_t id, unsigned char character) : m_id(id), m_character(character)
 {}
 
-Actor& Actor::operator=(const Actor& other)
+inline Actor::Actor(std::size_t id, unsigned char character, const Position<std::size_t> position)
+    : m_id(id), m_character(character), m_position(position)
+{}
+
+inline Actor& Actor::operator=(const Actor& other)
 {
     m_id = other.m_id;
     m_character = other.m_character;
+    m_position = other.m_position;
     return *this;
 }
 
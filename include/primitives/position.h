@@ -1,13 +1,15 @@
-/// @file matrix.h
+/// @file position.h
 /// @author Alberto Santagostino
 
 #ifndef PRIMITIVES_POSITION_H
 #define PRIMITIVES_POSITION_H
 
+#include <utility>
+
 namespace commonlib
 {
 /// @class Position
-/// @brief 2D generic matrix template
+/// @brief 2D generic position template
 /// @tparam T Type of data stored
 template <typename T>
 class Position
@@ -60,6 +62,18 @@ Position<T> operator+(const Position<T>& p1, const Position<T>& p2)
     return ret;
 }
 
+template <typename T>
+bool operator==(const Position<T>& p1, const Position<T>& p2)
+{
+    return (p1.x == p2.x) && (p1.y == p2.y);
+}
+
+template <typename T>
+bool operator!=(const Position<T>& p1, const Position<T>& p2)
+{
+    return !(p1 == p2);
+}
+
 }  // namespace commonlib
 
 #endif  // PRIMITIVES_POSITION_H
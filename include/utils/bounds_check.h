@@ -0,0 +1,56 @@
+/// @file bounds_check.h
+/// @author Alberto Santagostino
+
+#ifndef UTILS_BOUNDS_CHECK_H
+#define UTILS_BOUNDS_CHECK_H
+
+#include <cassert>
+#include <stdexcept>
+
+/// @brief Default bounds-check policy of the containers: 2 = checked (throw), 1 = assert only (checked in debug
+///        builds, free with NDEBUG), 0 = unchecked
+#ifndef COMMONLIB_BOUNDS_CHECK
+#define COMMONLIB_BOUNDS_CHECK 2
+#endif
+
+namespace commonlib
+{
+/// @struct BoundsChecked
+/// @brief Bounds-check policy: out-of-range indices throw std::out_of_range
+struct BoundsChecked
+{
+    static constexpr void Check(const bool in_range, const char* what)
+    {
+        if (!in_range) [[unlikely]]
+            throw std::out_of_range(what);
+    }
+};
+
+/// @struct BoundsAsserted
+/// @brief Bounds-check policy: out-of-range indices fail an assert, no check at all with NDEBUG
+struct BoundsAsserted
+{
+    static constexpr void Check([[maybe_unused]] const bool in_range, [[maybe_unused]] const char* what)
+    {
+        assert(in_range && what);
+    }
+};
+
+/// @struct BoundsUnchecked
+/// @brief Bounds-check policy: indices are trusted, out-of-range accesses are undefined behaviour
+struct BoundsUnchecked
+{
+    static constexpr void Check(const bool, const char*) {}
+};
+
+#if COMMONLIB_BOUNDS_CHECK == 0
+using DefaultBoundsCheck = BoundsUnchecked;
+#elif COMMONLIB_BOUNDS_CHECK == 1
+using DefaultBoundsCheck = BoundsAsserted;
+#else
+using DefaultBoundsCheck = BoundsChecked;
+#endif
+
+}  // namespace commonlib
+
+#endif  // UTILS_BOUNDS_CHECK_H
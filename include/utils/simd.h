@@ -0,0 +1,213 @@
+/// @file simd.h
+/// @author Alberto Santagostino
+
+#ifndef UTILS_SIMD_H
+#define UTILS_SIMD_H
+
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+namespace commonlib
+{
+namespace simd
+{
+/// @brief True if the kernels below have a hand-written vector path for T (1 and 4 bytes integers)
+template <typename T>
+inline constexpr bool kHasVectorPath =
+    std::is_integral_v<T> && !std::is_same_v<T, bool> && ((sizeof(T) == 1U) || (sizeof(T) == 4U));
+
+namespace detail
+{
+#if defined(__AVX2__)
+using Vector = __m256i;
+inline constexpr std::size_t kVectorBytes{32U};
+inline Vector Load(const void* ptr)
+{
+    return _mm256_loadu_si256(static_cast<const __m256i*>(ptr));
+}
+inline void Store(void* ptr, Vector v)
+{
+    _mm256_storeu_si256(static_cast<__m256i*>(ptr), v);
+}
+template <typename T>
+inline Vector Splat(const T value)
+{
+    if constexpr (sizeof(T) == 1U)
+        return _mm256_set1_epi8(static_cast<char>(value));
+    else
+        return _mm256_set1_epi32(static_cast<int>(value));
+}
+template <typename T>
+inline Vector CompareEqual(Vector a, Vector b)
+{
+    if constexpr (sizeof(T) == 1U)
+        return _mm256_cmpeq_epi8(a, b);
+    else
+        return _mm256_cmpeq_epi32(a, b);
+}
+inline std::uint32_t ByteMask(Vector v)
+{
+    return static_cast<std::uint32_t>(_mm256_movemask_epi8(v));
+}
+inline Vector Select(Vector mask, Vector if_true, Vector if_false)
+{
+    return _mm256_blendv_epi8(if_false, if_true, mask);
+}
+#elif defined(__SSE2__)
+using Vector = __m128i;
+inline constexpr std::size_t kVectorBytes{16U};
+inline Vector Load(const void* ptr)
+{
+    return _mm_loadu_si128(static_cast<const __m128i*>(ptr));
+}
+inline void Store(void* ptr, Vector v)
+{
+    _mm_storeu_si128(static_cast<__m128i*>(ptr), v);
+}
+template <typename T>
+inline Vector Splat(const T value)
+{
+    if constexpr (sizeof(T) == 1U)
+        return _mm_set1_epi8(static_cast<char>(value));
+    else
+        return _mm_set1_epi32(static_cast<int>(value));
+}
+template <typename T>
+inline Vector CompareEqual(Vector a, Vector b)
+{
+    if constexpr (sizeof(T) == 1U)
+        return _mm_cmpeq_epi8(a, b);
+    else
+        return _mm_cmpeq_epi32(a, b);
+}
+inline std::uint32_t ByteMask(Vector v)
+{
+    return static_cast<std::uint32_t>(_mm_movemask_epi8(v));
+}
+inline Vector Select(Vector mask, Vector if_true, Vector if_false)
+{
+    return _mm_or_si128(_mm_and_si128(mask, if_true), _mm_andnot_si128(mask, if_false));
+}
+#endif
+
+}  // namespace detail
+
+/// @brief Count the elements of [data, data + size) equal to value
+template <typename T>
+std::size_t Count(const T* data, const std::size_t size, const T value)
+{
+    std::size_t count{0U};
+    std::size_t i{0U};
+#if defined(__AVX2__) || defined(__SSE2__)
+    if constexpr (kHasVectorPath<T>)
+    {
+        constexpr std::size_t lanes{detail::kVectorBytes / sizeof(T)};
+        const detail::Vector needle = detail::Splat(value);
+        for (; i + lanes <= size; i += lanes)
+        {
+            const detail::Vector eq = detail::CompareEqual<T>(detail::Load(data + i), needle);
+            count += static_cast<std::size_t>(__builtin_popcount(detail::ByteMask(eq))) / sizeof(T);
+        }
+    }
+#endif
+    for (; i < size; ++i)
+        count += (data[i] == value) ? 1U : 0U;
+    return count;
+}
+
+/// @brief Index of the first element of [data, data + size) equal to value (size if not found)
+template <typename T>
+std::size_t FindFirst(const T* data, const std::size_t size, const T value)
+{
+    if constexpr (kHasVectorPath<T> && (sizeof(T) == 1U))
+    {
+        const void* found = std::memchr(data, static_cast<unsigned char>(value), size);
+        return (found == nullptr) ? size : static_cast<std::size_t>(static_cast<const T*>(found) - data);
+    }
+    else
+    {
+        return static_cast<std::size_t>(std::find(data, data + size, value) - data);
+    }
+}
+
+/// @brief Call callback(index) for every element of [data, data + size) equal to value, in increasing order
+template <typename T, typename Callback>
+void ForEachMatch(const T* data, const std::size_t size, const T value, Callback&& callback)
+{
+    std::size_t i{0U};
+#if defined(__AVX2__) || defined(__SSE2__)
+    if constexpr (kHasVectorPath<T>)
+    {
+        constexpr std::size_t lanes{detail::kVectorBytes / sizeof(T)};
+        const detail::Vector needle = detail::Splat(value);
+        for (; i + lanes <= size; i += lanes)
+        {
+            std::uint32_t mask = detail::ByteMask(detail::CompareEqual<T>(detail::Load(data + i), needle));
+            while (mask != 0U)
+            {
+                const int bit{__builtin_ctz(mask)};
+                callback(i + static_cast<std::size_t>(bit) / sizeof(T));
+                mask &= ~(((std::uint32_t{1} << sizeof(T)) - 1U) << bit);
+            }
+        }
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        if (data[i] == value) callback(i);
+    }
+}
+
+/// @brief Replace every element of [data, data + size) equal to old_value with new_value
+/// @return Number of replaced elements
+template <typename T>
+std::size_t Replace(T* data, const std::size_t size, const T old_value, const T new_value)
+{
+    std::size_t count{0U};
+    std::size_t i{0U};
+#if defined(__AVX2__) || defined(__SSE2__)
+    if constexpr (kHasVectorPath<T>)
+    {
+        constexpr std::size_t lanes{detail::kVectorBytes / sizeof(T)};
+        const detail::Vector needle = detail::Splat(old_value);
+        const detail::Vector replacement = detail::Splat(new_value);
+        for (; i + lanes <= size; i += lanes)
+        {
+            const detail::Vector chunk = detail::Load(data + i);
+            const detail::Vector eq = detail::CompareEqual<T>(chunk, needle);
+            count += static_cast<std::size_t>(__builtin_popcount(detail::ByteMask(eq))) / sizeof(T);
+            detail::Store(data + i, detail::Select(eq, replacement, chunk));
+        }
+    }
+#endif
+    for (; i < size; ++i)
+    {
+        if (data[i] == old_value)
+        {
+            data[i] = new_value;
+            ++count;
+        }
+    }
+    return count;
+}
+
+/// @brief Set every element of [data, data + size) to value
+template <typename T>
+void Fill(T* data, const std::size_t size, const T value)
+{
+    if constexpr (std::is_integral_v<T> && (sizeof(T) == 1U))
+        std::memset(data, static_cast<unsigned char>(value), size);
+    else
+        std::fill(data, data + size, value);
+}
+
+}  // namespace simd
+}  // namespace commonlib
+
+#endif  // UTILS_SIMD_H
@@ -0,0 +1,119 @@
+/// @file thread_pool.h
+/// @author Alberto Santagostino
+
+#ifndef UTILS_THREAD_POOL_H
+#define UTILS_THREAD_POOL_H
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace commonlib
+{
+/// @class ThreadPool
+/// @brief Fixed set of worker threads consuming a FIFO queue of tasks
+/// @note Tasks must not wait on other tasks of the same pool (e.g. calling ParallelFor from a worker)
+class ThreadPool
+{
+  public:
+    // Constructors
+    explicit ThreadPool(const std::size_t n_threads = std::thread::hardware_concurrency());
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    ~ThreadPool();
+
+    // Getters
+    inline std::size_t Size() const { return m_workers.size(); }
+
+    // Scheduling
+    template <typename F>
+    std::future<std::invoke_result_t<F>> Submit(F&& task);
+    void ParallelFor(const std::size_t n_tasks, const std::function<void(std::size_t)>& task);
+
+  private:
+    std::vector<std::thread> m_workers;
+    std::queue<std::function<void()>> m_tasks;
+    std::mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_stop{false};
+
+    void m_WorkerLoop();
+};
+
+/// @brief Constructor: start the worker threads
+/// @param n_threads Number of workers (at least one is always started)
+inline ThreadPool::ThreadPool(const std::size_t n_threads)
+{
+    const std::size_t workers{(n_threads == 0U) ? 1U : n_threads};
+    m_workers.reserve(workers);
+    for (std::size_t i{0U}; i < workers; ++i)
+        m_workers.emplace_back([this]() { m_WorkerLoop(); });
+}
+
+/// @brief Destructor: complete the queued tasks and join the workers
+inline ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_cv.notify_all();
+    for (auto& worker : m_workers)
+        worker.join();
+}
+
+/// @brief Queue a task
+/// @return Future holding the result (or the exception) of the task
+template <typename F>
+std::future<std::invoke_result_t<F>> ThreadPool::Submit(F&& task)
+{
+    using R = std::invoke_result_t<F>;
+    auto packaged = std::make_shared<std::packaged_task<R()>>(std::forward<F>(task));
+    std::future<R> result = packaged->get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.emplace([packaged]() { (*packaged)(); });
+    }
+    m_cv.notify_one();
+    return result;
+}
+
+/// @brief Run task(0) ... task(n_tasks - 1) on the pool and wait for all of them
+/// @throw The first exception (in task order) raised by a task, once all tasks are completed
+inline void ThreadPool::ParallelFor(const std::size_t n_tasks, const std::function<void(std::size_t)>& task)
+{
+    std::vector<std::future<void>> results;
+    results.reserve(n_tasks);
+    for (std::size_t i{0U}; i < n_tasks; ++i)
+        results.push_back(Submit([&task, i]() { task(i); }));
+    for (auto& result : results)
+        result.wait();
+    for (auto& result : results)
+        result.get();
+}
+
+inline void ThreadPool::m_WorkerLoop()
+{
+    while (true)
+    {
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_cv.wait(lock, [this]() { return m_stop || !m_tasks.empty(); });
+            if (m_tasks.empty()) return;
+            task = std::move(m_tasks.front());
+            m_tasks.pop();
+        }
+        task();
+    }
+}
+
+}  // namespace commonlib
+
+#endif  // UTILS_THREAD_POOL_H
@@ -0,0 +1,122 @@
+/// @file algorithms_components_tests.cpp
+/// @test commonlib::LabelComponents, commonlib::FloodFill
+
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <algorithms/components.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+class ComponentsTests : public Test
+{
+  protected:
+    Grid* grid;
+    virtual void SetUp()
+    {
+        grid = new Grid({{'#', '#', '.', '.', '~'},
+                         {'.', '#', '.', '#', '~'},
+                         {'.', '.', '#', '.', '.'},
+                         {'#', '.', '#', '#', '.'}});
+        grid->AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+        grid->AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+        grid->AddTileTypeDefinition(TileType::kTileType_Tree, '~');
+    }
+    virtual void TearDown() { delete grid; }
+};
+
+TEST_F(ComponentsTests, LabelByValueTest)
+{
+    const Components walls = LabelComponents(*grid, '#');
+    ASSERT_EQ(walls.Size(), 4U);
+    ASSERT_EQ(walls.labels, Matrix<std::uint32_t>({{1, 1, 0, 0, 0}, {0, 1, 0, 2, 0}, {0, 0, 3, 0, 0}, {4, 0, 3, 3, 0}}));
+    ASSERT_EQ(walls.components[0].size, 3U);
+    ASSERT_EQ(walls.components[2].first_row, 2U);
+    ASSERT_EQ(walls.components[2].last_col, 3U);
+    ASSERT_EQ(walls.At(3, 0).label, 4U);
+    ASSERT_EQ(walls.At(3, 0).value, '#');
+    ASSERT_THROW(walls.At(0, 2), std::out_of_range);
+
+    // With diagonals the walls from (0, 0) to (3, 3) are one component
+    const Components eight = LabelComponents(*grid, '#', Connectivity::kEight);
+    ASSERT_EQ(eight.Size(), 2U);
+    ASSERT_EQ(eight.At(3, 3).size, 7U);
+    ASSERT_EQ(eight.At(3, 3).first_row, 0U);
+    ASSERT_EQ(eight.At(3, 3).last_col, 3U);
+    ASSERT_EQ(eight.At(3, 0).size, 1U);
+
+    // A moved-from grid is empty
+    const Grid moved(std::move(*grid));
+    ASSERT_THROW(LabelComponents(*grid), std::length_error);
+    ASSERT_THROW(LabelComponents(*grid, '#'), std::length_error);
+    ASSERT_THROW(LabelComponents(*grid, TileType::kTileType_Wall), std::length_error);
+    ASSERT_EQ(LabelComponents(moved, '#').Size(), 4U);
+}
+
+TEST_F(ComponentsTests, LabelAllAndTileTypeTest)
+{
+    const Components all = LabelComponents(*grid);
+    std::size_t cells{0U};
+    for (const Component& component : all.components)
+        cells += component.size;
+    ASSERT_EQ(cells, 20U);
+    ASSERT_EQ(all.At(0, 4).value, '~');
+    ASSERT_EQ(all.At(0, 4).size, 2U);
+    ASSERT_EQ(all.At(0, 2).size, 3U);
+    ASSERT_NE(all.labels(0, 2), all.labels(2, 3));
+
+    const Components empty = LabelComponents(*grid, TileType::kTileType_Empty);
+    ASSERT_EQ(empty.Size(), 3U);
+    ASSERT_EQ(empty.At(3, 1).size, 4U);
+    ASSERT_EQ(empty.At(3, 1).first_row, 1U);
+    ASSERT_EQ(LabelComponents(*grid, TileType::kTileType_Tree).At(1, 4).size, 2U);
+    ASSERT_EQ(LabelComponents(*grid, TileType::kTileType_Undefined).Size(), 0U);
+}
+
+TEST_F(ComponentsTests, ParallelTest)
+{
+    std::mt19937 rng(7U);
+    Grid big(97U, 61U, '.');
+    for (std::size_t r{0U}; r < big.NRows(); ++r)
+        for (std::size_t c{0U}; c < big.NCols(); ++c)
+            big(r, c) = (rng() % 100U < 45U) ? '#' : '.';
+    ThreadPool pool(4U);
+    for (const Connectivity connectivity : {Connectivity::kFour, Connectivity::kEight})
+    {
+        const Components serial = LabelComponents(big, '#', connectivity);
+        const Components parallel = LabelComponents(big, '#', connectivity, &pool);
+        ASSERT_EQ(serial.labels, parallel.labels);
+        ASSERT_EQ(serial.Size(), parallel.Size());
+
+        // Flood filling every component from its first cell writes exactly its cells
+        Grid copy(big);
+        for (const Component& component : serial.components)
+        {
+            std::size_t col{component.first_col};
+            while (serial.labels(component.first_row, col) != component.label)
+                ++col;
+            ASSERT_EQ(FloodFill(copy, component.first_row, col, 'x', connectivity), component.size);
+        }
+        ASSERT_EQ(copy.CountElements('#'), 0U);
+    }
+}
+
+TEST_F(ComponentsTests, FloodFillTest)
+{
+    grid->TrackChanges(true);
+    ASSERT_EQ(FloodFill(*grid, 1, 0, 'o'), 4U);
+    ASSERT_EQ((*grid)(3, 1), 'o');
+    ASSERT_EQ((*grid)(0, 2), '.');
+    ASSERT_EQ(grid->CommitChanges(), 4U);
+    ASSERT_EQ(FloodFill(*grid, 1, 0, 'o'), 0U);
+    ASSERT_EQ(FloodFill(*grid, 0, 2, 'o', Connectivity::kEight), 6U);
+    ASSERT_EQ(grid->CountElements('o'), 10U);
+    ASSERT_THROW(FloodFill(*grid, 4, 0, 'o'), std::out_of_range);
+
+    // No recursion: a single region as big as the grid
+    Grid big(1000U, 1000U, '.');
+    ASSERT_EQ(FloodFill(big, 500, 500, '#'), 1000000U);
+}
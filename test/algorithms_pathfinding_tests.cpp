@@ -0,0 +1,139 @@
+/// @file algorithms_pathfinding_tests.cpp
+/// @test commonlib::Pathfinder
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <algorithms/pathfinding.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+class PathfinderTests : public Test
+{
+  protected:
+    Grid* grid;
+    virtual void SetUp()
+    {
+        grid = new Grid({{'.', '.', '.', '.', '.'},
+                         {'#', '#', '#', '#', '.'},
+                         {'.', '.', '.', '.', '.'},
+                         {'.', '#', '#', '#', '.'},
+                         {'.', '~', '~', '.', '.'}});
+        grid->AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+        grid->AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+        grid->AddTileTypeDefinition(TileType::kTileType_Tree, '~');
+    }
+    virtual void TearDown() { delete grid; }
+};
+
+TEST_F(PathfinderTests, SingleQueryTest)
+{
+    Pathfinder pathfinder(*grid);
+    ASSERT_TRUE(pathfinder.IsWalkable({0, 0}));
+    ASSERT_FALSE(pathfinder.IsWalkable({1, 1}));
+    ASSERT_FALSE(pathfinder.IsWalkable({1, 4}));  // Trees are not walkable by default
+
+    for (const auto algorithm : {PathAlgorithm::kBfs, PathAlgorithm::kDijkstra, PathAlgorithm::kAStar,
+                                 PathAlgorithm::kJumpPoint})
+    {
+        const auto path = pathfinder.FindPath({0, 0}, {3, 4}, algorithm);
+        ASSERT_TRUE(path.has_value());
+        ASSERT_DOUBLE_EQ(path->cost, 9.0);
+        ASSERT_EQ(path->cells.size(), 10U);
+        ASSERT_EQ(path->cells.front(), Position<std::size_t>(0, 0));
+        ASSERT_EQ(path->cells.back(), Position<std::size_t>(3, 4));
+        for (std::size_t i{1U}; i < path->cells.size(); ++i)
+        {
+            ASSERT_TRUE(pathfinder.IsWalkable(path->cells[i]));
+            const auto dx = long(path->cells[i].x) - long(path->cells[i - 1U].x);
+            const auto dy = long(path->cells[i].y) - long(path->cells[i - 1U].y);
+            ASSERT_EQ(std::abs(dx) + std::abs(dy), 1);
+        }
+    }
+    ASSERT_FALSE(pathfinder.FindPath({0, 0}, {1, 4}).has_value());
+    ASSERT_FALSE(pathfinder.FindPath({0, 0}, {0, 1}).has_value());
+    ASSERT_EQ(pathfinder.FindPath({2, 2}, {2, 2})->cells.size(), 1U);
+    ASSERT_THROW(pathfinder.FindPath({5, 0}, {0, 0}), std::out_of_range);
+
+    // Walking through the trees is shorter but more expensive
+    Pathfinder costly(*grid, {{TileType::kTileType_Empty, 1.0}, {TileType::kTileType_Tree, 10.0}});
+    ASSERT_DOUBLE_EQ(costly.FindPath({0, 2}, {3, 4}, PathAlgorithm::kDijkstra)->cost, 7.0);
+    ASSERT_DOUBLE_EQ(costly.FindPath({0, 2}, {3, 4}, PathAlgorithm::kAStar)->cost, 7.0);
+    ASSERT_DOUBLE_EQ(costly.FindPath({0, 2}, {3, 4}, PathAlgorithm::kJumpPoint)->cost, 7.0);
+    ASSERT_DOUBLE_EQ(costly.FindPath({0, 2}, {3, 4}, PathAlgorithm::kBfs)->cost, 5.0);
+    Pathfinder cheap(*grid, {{TileType::kTileType_Empty, 2.0}, {TileType::kTileType_Tree, 1.0}});
+    ASSERT_DOUBLE_EQ(cheap.FindPath({0, 2}, {3, 4}, PathAlgorithm::kAStar)->cost, 2.0 + 2.0 + 1.0 + 1.0 + 2.0);
+    ASSERT_THROW(Pathfinder(*grid, {{TileType::kTileType_Empty, -1.0}}), std::invalid_argument);
+}
+
+TEST_F(PathfinderTests, BatchedQueryTest)
+{
+    Pathfinder pathfinder(*grid);
+    const auto path = pathfinder.FindPath({{0, 0}, {4, 4}}, {{0, 2}, {4, 2}});
+    ASSERT_TRUE(path.has_value());
+    ASSERT_DOUBLE_EQ(path->cost, 2.0);
+    ASSERT_EQ(path->cells.front(), Position<std::size_t>(4, 4));
+    ASSERT_EQ(path->cells.back(), Position<std::size_t>(4, 2));
+
+    const Matrix<double> distances = pathfinder.Distances({{0, 0}, {0, 4}}, PathAlgorithm::kBfs);
+    ASSERT_DOUBLE_EQ(distances(0, 4), 4.0);
+    ASSERT_DOUBLE_EQ(distances(2, 0), 2.0);
+    ASSERT_DOUBLE_EQ(distances(4, 3), 9.0);
+    ASSERT_TRUE(std::isinf(distances(1, 0)));
+    ASSERT_TRUE(std::isinf(distances(4, 1)));
+}
+
+TEST(PathfinderRandomTests, AlgorithmsAgreeTest)
+{
+    // Random maps: every algorithm finds paths of the same cost, the scratch state is reused across queries
+    std::mt19937 rng(42U);
+    for (const bool diagonals : {false, true})
+    {
+        Grid grid(40, 50, '.');
+        grid.AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+        grid.AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+        for (std::size_t row{0U}; row < grid.NRows(); ++row)
+            for (std::size_t col{0U}; col < grid.NCols(); ++col)
+                if (rng() % 100U < 30U) grid(row, col) = '#';
+        Pathfinder pathfinder(grid, {{TileType::kTileType_Empty, 1.0}}, diagonals);
+        std::size_t astar_expanded{0U};
+        std::size_t jps_expanded{0U};
+        for (int query{0}; query < 200; ++query)
+        {
+            const Position<std::size_t> source(rng() % 50U, rng() % 40U);
+            const Position<std::size_t> target(rng() % 50U, rng() % 40U);
+            const auto dijkstra = pathfinder.FindPath(source, target, PathAlgorithm::kDijkstra);
+            const auto astar = pathfinder.FindPath(source, target, PathAlgorithm::kAStar);
+            astar_expanded += pathfinder.ExpandedNodes();
+            const auto jps = pathfinder.FindPath(source, target, PathAlgorithm::kJumpPoint);
+            jps_expanded += pathfinder.ExpandedNodes();
+            const auto bfs = pathfinder.FindPath(source, target, PathAlgorithm::kBfs);
+            ASSERT_EQ(dijkstra.has_value(), astar.has_value());
+            ASSERT_EQ(dijkstra.has_value(), jps.has_value());
+            ASSERT_EQ(dijkstra.has_value(), bfs.has_value());
+            if (!dijkstra) continue;
+            ASSERT_NEAR(astar->cost, dijkstra->cost, 1e-9);
+            ASSERT_NEAR(jps->cost, dijkstra->cost, 1e-9);
+            ASSERT_EQ(jps->cells.front(), source);
+            ASSERT_EQ(jps->cells.back(), target);
+            for (std::size_t i{1U}; i < jps->cells.size(); ++i)
+            {
+                ASSERT_TRUE(pathfinder.IsWalkable(jps->cells[i]));
+                const auto dx = std::abs(long(jps->cells[i].x) - long(jps->cells[i - 1U].x));
+                const auto dy = std::abs(long(jps->cells[i].y) - long(jps->cells[i - 1U].y));
+                ASSERT_EQ(std::max(dx, dy), 1);
+            }
+            if (!diagonals)
+            {
+                ASSERT_DOUBLE_EQ(bfs->cost, dijkstra->cost);
+            }
+        }
+        if (diagonals)
+        {
+            ASSERT_LT(jps_expanded, astar_expanded);
+        }
+    }
+}
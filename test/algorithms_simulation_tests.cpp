@@ -0,0 +1,122 @@
+/// @file algorithms_simulation_tests.cpp
+/// @test commonlib::Simulation
+
+#include <vector>
+
+#include <algorithms/simulation.h>
+#include <algorithms/stencil.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+static char LifeRule(const char& center, RowView<const char> neighbours)
+{
+    int alive{0};
+    for (const char cell : neighbours)
+        alive += (cell == '#') ? 1 : 0;
+    return ((alive == 3) || ((alive == 2) && (center == '#'))) ? '#' : '.';
+}
+
+// Row 0 goes from 'a' to 'b' once, the '#' of row 1 moves right (wrapping) at every step
+static void Rotate(Grid& grid)
+{
+    grid(0, 0) = 'b';
+    const char last{grid(1, 4)};
+    for (std::size_t col{4U}; col > 0U; --col)
+        grid(1, col) = grid(1, col - 1U);
+    grid(1, 0) = last;
+}
+
+TEST(SimulationTests, CycleTest)
+{
+    Grid grid({{'a', '.', '.', '.', '.'}, {'#', '.', '.', '.', '.'}});
+    Simulation simulation(grid, Rotate);
+    ASSERT_TRUE(grid.IsHashing());
+    ASSERT_FALSE(simulation.FindCycle(3U).has_value());
+    ASSERT_EQ(simulation.CurrentStep(), 3U);
+
+    const std::optional<Cycle> cycle = simulation.FindCycle(100U);
+    ASSERT_TRUE(cycle.has_value());
+    ASSERT_EQ(cycle->start, 1U);
+    ASSERT_EQ(cycle->period, 5U);
+    ASSERT_EQ(simulation.CurrentStep(), 6U);
+    ASSERT_EQ(simulation.History().size(), 6U);
+    ASSERT_EQ(simulation.EquivalentStep(1000000000U), 5U);
+    ASSERT_EQ(simulation.EquivalentStep(0U), 0U);
+
+    // Skip ahead without running the steps, then back inside the cycle
+    simulation.AdvanceTo(1000000003U);
+    ASSERT_EQ(simulation.CurrentStep(), 1000000003U);
+    ASSERT_EQ(grid(1, 3), '#');
+    simulation.AdvanceTo(2U);
+    ASSERT_EQ(grid(1, 2), '#');
+    ASSERT_EQ(grid.Hash(), simulation.History()[2]);
+    ASSERT_THROW(simulation.AdvanceTo(0U), std::logic_error);
+}
+
+TEST(SimulationTests, AdvanceTest)
+{
+    // AdvanceTo finds the cycle on the way
+    Grid grid({{'a', '.', '.', '.', '.'}, {'#', '.', '.', '.', '.'}});
+    Simulation simulation(grid, Rotate);
+    simulation.AdvanceTo(2U);
+    ASSERT_EQ(grid(1, 2), '#');
+    ASSERT_FALSE(simulation.GetCycle().has_value());
+    simulation.AdvanceTo(1234567U);
+    ASSERT_TRUE(simulation.GetCycle().has_value());
+    ASSERT_EQ(grid(1, 1234567U % 5U), '#');
+    ASSERT_EQ(grid.CountElements('#'), 1U);
+}
+
+TEST(SimulationTests, StencilTest)
+{
+    // A glider on a torus comes back after 4 steps per cell travelled diagonally
+    Grid grid(8U, 8U, '.');
+    grid(0, 1) = '#';
+    grid(1, 2) = '#';
+    grid(2, 0) = '#';
+    grid(2, 1) = '#';
+    grid(2, 2) = '#';
+    const Grid start(grid);
+    grid.TrackChanges(true);
+    Stencil life(grid, LifeRule, StencilOptions<char>{Neighbourhood::kMoore, 3U, '.', true});
+    Simulation simulation(grid, [&life](Grid&) { life.Step(); }, true);
+    const std::optional<Cycle> cycle = simulation.FindCycle(1000U);
+    ASSERT_TRUE(cycle.has_value());
+    ASSERT_EQ(cycle->start, 0U);
+    ASSERT_EQ(cycle->period, 32U);
+    simulation.AdvanceTo(32U * 1000000U);
+    ASSERT_TRUE(grid == start);
+}
+
+TEST(SimulationTests, UntrackedStencilTest)
+{
+    // Two untracked steps swap the grid back onto its first buffer: the hash must still see the new cells
+    Grid grid(8U, 8U, '.');
+    grid(0, 1) = '#';
+    grid(1, 2) = '#';
+    grid(2, 0) = '#';
+    grid(2, 1) = '#';
+    grid(2, 2) = '#';
+    Stencil life(grid, LifeRule, StencilOptions<char>{Neighbourhood::kMoore, 3U, '.', true});
+    Simulation simulation(grid, [&life](Grid&) { life.Run(2U); }, true);
+    const std::optional<Cycle> cycle = simulation.FindCycle(1000U);
+    ASSERT_TRUE(cycle.has_value());
+    ASSERT_EQ(cycle->start, 0U);
+    ASSERT_EQ(cycle->period, 16U);
+}
+
+TEST(SimulationTests, RawWritesTest)
+{
+    // Writes through operator[] are not logged: by default the cells are rehashed after every step
+    Grid grid(3U, 3U, '.');
+    Simulation simulation(grid, [](Grid& g) { g[0][0] = (g[0][0] == '.') ? '#' : '.'; });
+    const std::optional<Cycle> cycle = simulation.FindCycle(10U);
+    ASSERT_TRUE(cycle.has_value());
+    ASSERT_EQ(cycle->start, 0U);
+    ASSERT_EQ(cycle->period, 2U);
+    ASSERT_NE(simulation.History()[0], simulation.History()[1]);
+    simulation.AdvanceTo(7U);
+    ASSERT_EQ(grid(0, 0), '#');
+}
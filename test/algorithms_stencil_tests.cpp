@@ -0,0 +1,172 @@
+/// @file algorithms_stencil_tests.cpp
+/// @test commonlib::Stencil
+
+#include <vector>
+
+#include <algorithms/stencil.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+static char LifeRule(const char& center, RowView<const char> neighbours)
+{
+    int alive{0};
+    for (const char cell : neighbours)
+        alive += (cell == '#') ? 1 : 0;
+    return ((alive == 3) || ((alive == 2) && (center == '#'))) ? '#' : '.';
+}
+
+TEST(StencilTests, LifeTest)
+{
+    Grid grid({{'.', '.', '.', '.', '.'},
+               {'.', '.', '#', '.', '.'},
+               {'.', '.', '#', '.', '.'},
+               {'.', '.', '#', '.', '.'},
+               {'.', '.', '.', '.', '.'}});
+    const Grid start(grid);
+    Stencil life(grid, LifeRule, StencilOptions<char>{Neighbourhood::kMoore, 3U, '.'});
+    ASSERT_EQ(life.NeighbourCount(), 8U);
+    ASSERT_EQ(life.Step(), 4U);
+    ASSERT_EQ(grid.Row(2), std::vector<char>({'.', '#', '#', '#', '.'}));
+    ASSERT_EQ(grid.CountElements('#'), 3U);
+    life.Step();
+    ASSERT_TRUE(grid == start);
+    ASSERT_EQ(life.Steps(), 2U);
+    ASSERT_GT(life.StepsPerSecond(), 0.0);
+
+    // A block is a fixed point
+    Grid block({{'.', '.', '.', '.'}, {'.', '#', '#', '.'}, {'.', '#', '#', '.'}, {'.', '.', '.', '.'}});
+    Stencil still(block, LifeRule, StencilOptions<char>{Neighbourhood::kMoore, 3U, '.'});
+    ASSERT_EQ(still.Run(10, true), 1U);
+}
+
+TEST(StencilTests, TilePlaneTest)
+{
+    // Two untracked steps swap the grid back onto its first buffer: the tile plane must still see the new cells
+    Grid grid(4, 4, '.');
+    grid.AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+    grid.MaterializeTiles(true);
+    ASSERT_EQ(grid.CountTiles(TileType::kTileType_Wall), 0U);
+    Stencil fill(grid, [](const char&, RowView<const char>) { return '#'; });
+    fill.Run(2);
+    ASSERT_EQ(grid.CountTiles(TileType::kTileType_Wall), 16U);
+}
+
+TEST(StencilTests, ValueIndexTest)
+{
+    // Two untracked steps swap the grid back onto its first buffer: the value index must still see the new cells
+    Grid grid(4, 4, '.');
+    grid.IndexValues({'#'});
+    ASSERT_EQ(grid.CountInRectangle('#', 0, 0, 3, 3), 0U);
+    Stencil fill(grid, [](const char&, RowView<const char>) { return '#'; });
+    fill.Run(2);
+    ASSERT_EQ(grid.CountInRectangle('#', 0, 0, 3, 3), 16U);
+}
+
+TEST(StencilTests, WrapTest)
+{
+    auto sum = [](const int&, RowView<const int> neighbours) {
+        int total{0};
+        for (const int value : neighbours)
+            total += value;
+        return total;
+    };
+    Matrix<int> clamped({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+    Stencil clamped_sum(clamped, sum, StencilOptions<int>{Neighbourhood::kVonNeumann, 3U, 0});
+    clamped_sum.Step();
+    ASSERT_EQ(clamped(0, 0), 2 + 4);
+    ASSERT_EQ(clamped(1, 1), 2 + 4 + 6 + 8);
+
+    Matrix<int> wrapped({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+    Stencil wrapped_sum(wrapped, sum, StencilOptions<int>{Neighbourhood::kVonNeumann, 3U, 0, true});
+    wrapped_sum.Step();
+    ASSERT_EQ(wrapped(0, 0), 7 + 3 + 2 + 4);
+
+    // Infinite grids always wrap, windows include the center
+    Grid grid({{'#', '.', '.'}, {'.', '.', '.'}, {'.', '.', '.'}});
+    grid.MakeInfinite(true);
+    auto count = [](const char&, RowView<const char> window) {
+        int hashes{0};
+        for (const char cell : window)
+            hashes += (cell == '#') ? 1 : 0;
+        return char('0' + hashes);
+    };
+    Stencil window(grid, count, StencilOptions<char>{Neighbourhood::kWindow, 3U, '.'});
+    ASSERT_EQ(window.NeighbourCount(), 9U);
+    window.Step();
+    ASSERT_EQ(grid.CountElements('1'), 9U);
+    ASSERT_THROW(Stencil(grid, count, StencilOptions<char>{Neighbourhood::kWindow, 4U}), std::out_of_range);
+}
+
+TEST(StencilTests, ParallelTest)
+{
+    Matrix<int> serial(37, 23);
+    for (std::size_t r{0U}; r < serial.NRows(); ++r)
+        for (std::size_t c{0U}; c < serial.NCols(); ++c)
+            serial(r, c) = int((r * 31 + c * 17) % 11);
+    Matrix<int> parallel(serial);
+    auto max = [](const int& center, RowView<const int> window) {
+        int best{center};
+        for (const int value : window)
+            best = std::max(best, value);
+        return best;
+    };
+    ThreadPool pool(4);
+    Stencil serial_max(serial, max, StencilOptions<int>{Neighbourhood::kWindow, 5U, -1});
+    Stencil parallel_max(parallel, max, StencilOptions<int>{Neighbourhood::kWindow, 5U, -1}, &pool);
+    serial_max.Run(3);
+    parallel_max.Run(3);
+    ASSERT_TRUE(serial == parallel);
+}
+
+TEST(StencilTests, UncheckedMatrixTest)
+{
+    // The back buffer keeps the bounds-check policy of the matrix
+    Matrix<int, BoundsUnchecked> unchecked({{1, 2, 3}, {4, 5, 6}, {7, 8, 9}});
+    auto sum = [](const int&, RowView<const int> neighbours) {
+        int total{0};
+        for (const int value : neighbours)
+            total += value;
+        return total;
+    };
+    Stencil unchecked_sum(unchecked, sum, StencilOptions<int>{Neighbourhood::kVonNeumann, 3U, 0});
+    ASSERT_EQ(unchecked_sum.Step(), 9U);
+    ASSERT_EQ(unchecked(0, 0), 2 + 4);
+    ASSERT_EQ(unchecked(1, 1), 2 + 4 + 6 + 8);
+}
+
+TEST(StencilTests, TrackedGridTest)
+{
+    // Glider on a torus: the tracked incremental steps must match the full ones
+    Grid full(16, 16, '.');
+    for (const auto& [row, col] : std::vector<std::pair<std::size_t, std::size_t>>{{0, 1}, {1, 2}, {2, 0}, {2, 1}, {2, 2}})
+        full(row, col) = '#';
+    Grid tracked(full);
+    full.MakeInfinite(true);
+    tracked.MakeInfinite(true);
+    tracked.TrackChanges(true);
+    ThreadPool pool(3);
+    Stencil full_life(full, LifeRule);
+    Stencil tracked_life(tracked, LifeRule, {}, &pool);
+    for (int step{0}; step < 40; ++step)
+    {
+        ASSERT_EQ(tracked_life.Step(), full_life.Step());
+        ASSERT_TRUE(tracked == full);
+        ASSERT_LE(tracked.ActiveCells().size(), 5U * 9U);
+    }
+    ASSERT_FALSE(tracked.IsFixedPoint());
+
+    // A block settles immediately
+    Grid block({{'.', '.', '.', '.'}, {'.', '#', '#', '.'}, {'.', '#', '#', '.'}, {'.', '.', '.', '.'}});
+    block.TrackChanges(true);
+    Stencil still(block, LifeRule, StencilOptions<char>{Neighbourhood::kMoore, 3U, '.'});
+    ASSERT_EQ(still.Run(10, true), 1U);
+    ASSERT_TRUE(block.IsFixedPoint());
+    block(0, 0) = '#';
+    // (0, 0) dies again (no net change), (1, 1) dies of overcrowding, (0, 1) and (1, 0) are born
+    ASSERT_EQ(still.Step(), 3U);
+    ASSERT_EQ(block(0, 0), '.');
+    ASSERT_EQ(block.Row(0), std::vector<char>({'.', '#', '.', '.'}));
+    ASSERT_EQ(block.Row(1), std::vector<char>({'#', '.', '#', '.'}));
+}
@@ -0,0 +1,78 @@
+/// @file data_structures_actor_store_tests.cpp
+/// @test commonlib::ActorStore
+
+#include <vector>
+
+#include <data_structures/actor_store.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+TEST(ActorStoreTests, IndexTest)
+{
+    ActorStore<long> store;
+    ASSERT_TRUE(store.Add(7U, 'a', Position<long>(1, 2)));
+    ASSERT_TRUE(store.Add(1000000U, 'b', Position<long>(3, 4), Position<long>(1, -1)));
+    ASSERT_TRUE(store.Add(3U, 'c', Position<long>(5, 6)));
+    ASSERT_FALSE(store.Add(7U, 'x', Position<long>(0, 0)));
+    ASSERT_EQ(store.Size(), 3U);
+    ASSERT_EQ(store.IndexOf(1000000U), std::optional<std::size_t>(1U));
+    ASSERT_FALSE(store.Contains(8U));
+    ASSERT_FALSE(store.Contains(1U << 30));
+
+    // Removal moves the last actor, ids stay valid
+    ASSERT_TRUE(store.Remove(7U));
+    ASSERT_FALSE(store.Remove(7U));
+    ASSERT_EQ(store.Size(), 2U);
+    ASSERT_EQ(store.IndexOf(3U), std::optional<std::size_t>(0U));
+    ASSERT_EQ(store.Ids(), std::vector<std::size_t>({3U, 1000000U}));
+    ASSERT_EQ(store.Characters(), std::vector<char>({'c', 'b'}));
+    ASSERT_EQ(store.GetPosition(3U), Position<long>(5, 6));
+    ASSERT_EQ(store.GetVelocity(1000000U), Position<long>(1, -1));
+    ASSERT_THROW(store.GetPosition(7U), std::out_of_range);
+
+    store.SetPosition(3U, Position<long>(-1, -2));
+    store.SetVelocity(3U, Position<long>(2, 2));
+    ASSERT_EQ(store.X(), std::vector<long>({-1, 3}));
+    ASSERT_EQ(store.VelocityY(), std::vector<long>({2, -1}));
+    store.Clear();
+    ASSERT_EQ(store.Size(), 0U);
+    ASSERT_FALSE(store.Contains(3U));
+}
+
+TEST(ActorStoreTests, PassesTest)
+{
+    ActorStore<int> store;
+    store.Reserve(1000U);
+    for (std::size_t id{0U}; id < 1000U; ++id)
+        store.Add(id, 'a', Position<int>(int(id), -int(id)), Position<int>(1, int(id % 3U)));
+    store.Move(Position<int>(10, 20));
+    store.ApplyVelocity();
+    ASSERT_EQ(store.GetPosition(500U), Position<int>(511, -500 + 20 + 2));
+    ASSERT_EQ(store.GetPosition(999U), Position<int>(1010, -999 + 20 + 0));
+}
+
+TEST(ActorStoreTests, GridCollisionTest)
+{
+    Grid grid({{'.', '.', '.'}, {'.', '#', '.'}, {'.', '.', '.'}});
+    grid.AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+    grid.AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+    ActorStore<long> store;
+    store.Add(0U, 'a', Position<long>(0, 1), Position<long>(1, 0));   // Into the wall
+    store.Add(1U, 'b', Position<long>(0, 0), Position<long>(2, 0));   // Free
+    store.Add(2U, 'c', Position<long>(2, 2), Position<long>(0, 1));   // Out of the grid
+    store.Add(3U, 'd', Position<long>(1, 1), Position<long>(0, 0));   // Standing on the wall
+    ASSERT_EQ(store.CollideWithGrid(grid), std::vector<std::size_t>({3U}));
+    ASSERT_EQ(store.ApplyVelocity(grid), 3U);
+    ASSERT_EQ(store.GetPosition(0U), Position<long>(0, 1));
+    ASSERT_EQ(store.GetVelocity(0U), Position<long>(0, 0));
+    ASSERT_EQ(store.GetPosition(1U), Position<long>(2, 0));
+    ASSERT_EQ(store.GetPosition(2U), Position<long>(2, 2));
+
+    // Infinite grids wrap
+    grid.MakeInfinite(true);
+    store.SetVelocity(2U, Position<long>(0, 1));
+    ASSERT_EQ(store.ApplyVelocity(grid), 1U);
+    ASSERT_EQ(store.GetPosition(2U), Position<long>(2, 0));
+}
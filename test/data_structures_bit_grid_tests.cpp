@@ -0,0 +1,73 @@
+/// @file data_structures_bit_grid_tests.cpp
+/// @test commonlib::BitGrid
+
+#include <string>
+#include <vector>
+
+#include <data_structures/bit_grid.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+class BitGridTests : public ::testing::Test
+{
+  protected:
+    Grid* grid;
+    virtual void SetUp()
+    {
+        grid = new Grid({{'.', '.', '.'}, {'x', 'x', '.'}, {'.', 'x', '.'}});
+        grid->AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+        grid->AddTileTypeDefinition(TileType::kTileType_Wall, 'x');
+    }
+    virtual void TearDown() { delete grid; }
+};
+
+TEST_F(BitGridTests, ConversionTest)
+{
+    BitGrid bits(*grid);
+    ASSERT_EQ(bits.NRows(), 3U);
+    ASSERT_EQ(bits.NCols(), 3U);
+    ASSERT_EQ(bits.WordsPerRow(), 1U);
+    ASSERT_EQ(bits.Count(), 3U);
+    ASSERT_EQ(bits.CountRow(1), 2U);
+    ASSERT_TRUE(bits.Get(2, 1));
+    ASSERT_FALSE(bits.Get(0, 0));
+    ASSERT_TRUE(bits.ToGrid(grid->GetTilesMap()) == *grid);
+
+    grid->operator()(0, 0) = '?';
+    ASSERT_THROW(BitGrid{*grid}, std::invalid_argument);
+    ASSERT_THROW(BitGrid(*grid, TilesMap()), std::invalid_argument);
+}
+
+TEST_F(BitGridTests, ShiftTest)
+{
+    // Wide enough to cross word boundaries
+    BitGrid bits(3, 130);
+    bits.Set(1, 63);
+    bits.Set(1, 129);
+    auto right = bits.Shifted(0, 1);
+    ASSERT_TRUE(right.Get(1, 64));
+    ASSERT_EQ(right.Count(), 1U);
+    auto left = bits.Shifted(1, -65);
+    ASSERT_TRUE(left.Get(2, 64));
+    ASSERT_EQ(left.Count(), 1U);
+    ASSERT_EQ(bits.Shifted(0, 200).Count(), 0U);
+    ASSERT_EQ((~bits).Count(), 3U * 130U - 2U);
+    ASSERT_TRUE((bits ^ bits).Count() == 0U);
+}
+
+TEST_F(BitGridTests, NeighboursTest)
+{
+    BitGrid bits(*grid);
+    auto dilated = bits.Dilated(false);
+    ASSERT_EQ(dilated.Count(), 8U);
+    ASSERT_FALSE(dilated.Get(0, 2));
+    ASSERT_EQ(bits.Dilated(true).Count(), 9U);
+
+    auto counts = bits.NeighbourCounts(true);
+    ASSERT_EQ(counts[0], 2U);
+    ASSERT_EQ(counts[1 * 3 + 1], 2U);
+    ASSERT_EQ(counts[2 * 3 + 2], 2U);
+    ASSERT_EQ(bits.NeighbourCounts(false)[2 * 3 + 0], 2U);
+}
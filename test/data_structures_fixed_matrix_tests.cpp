@@ -0,0 +1,44 @@
+/// @file data_structures_fixed_matrix_tests.cpp
+/// @test commonlib::FixedMatrix
+
+#include <vector>
+
+#include <data_structures/fixed_matrix.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+// Construction, indexing, comparison and counting are usable in constant expressions
+constexpr FixedMatrix<int, 2, 3> kMatrix({{1, 2, 3}, {4, 5, 4}});
+static_assert(kMatrix(1, 2) == 4);
+static_assert(kMatrix[0][1] == 2);
+static_assert(kMatrix.CountElements(4) == 2U);
+static_assert(kMatrix == FixedMatrix<int, 2, 3>({{1, 2, 3}, {4, 5, 4}}));
+static_assert(FixedMatrix<int, 2, 2>(7).CountElements(7) == 4U);
+static_assert(sizeof(FixedMatrix<char, 3, 3>) == 9U);
+
+TEST(FixedMatrixTests, AccessTests)
+{
+    FixedMatrix<int, 2, 3> matrix(kMatrix);
+    ASSERT_EQ(matrix.NRows(), 2U);
+    ASSERT_EQ(matrix.NCols(), 3U);
+    ASSERT_FALSE(matrix.IsSquare());
+    ASSERT_EQ(matrix.Data(), std::vector<std::vector<int>>({{1, 2, 3}, {4, 5, 4}}));
+    matrix(0, 0) = 9;
+    matrix[1][1] = 8;
+    ASSERT_EQ(matrix.View().Row(1), std::vector<int>({4, 8, 4}));
+    ASSERT_TRUE(matrix != kMatrix);
+    matrix.Fill(0);
+    ASSERT_EQ(matrix.CountElements(0), 6U);
+    ASSERT_EQ((FixedMatrix<double, 1, 1>()(0, 0)), 0.0);
+}
+
+TEST(FixedMatrixTests, ExceptionsTests)
+{
+    FixedMatrix<int, 2, 3> matrix;
+    ASSERT_THROW(matrix(2, 0), std::out_of_range);
+    ASSERT_THROW(matrix(0, 3), std::out_of_range);
+    ASSERT_THROW((FixedMatrix<int, 2, 2>({{1, 2}})), std::length_error);
+    ASSERT_THROW((FixedMatrix<int, 1, 2>({{1, 2, 3}})), std::length_error);
+}
@@ -1,8 +1,11 @@
 /// @file data_structures_grid_tests.cpp
 /// @test commonlib::Grid
 
+#include <cstdio>
 #include <iostream>
 #include <string>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 #include <data_structures/grid.h>
@@ -28,6 +31,192 @@ TEST_F(GridTests, FileLoadingTest)
     fp.close();
 }
 
+TEST_F(GridTests, MappedFileLoadingTest)
+{
+    MappedFile file("data/input_grid.txt");
+    Grid gridmf(file, '\0');
+    ASSERT_TRUE(gridmf == *grid);
+
+    Grid borrowed(std::make_shared<MappedFile>("data/input_grid.txt"));
+    ASSERT_TRUE(borrowed == *grid);
+    ASSERT_EQ(borrowed.RowStride(), 4U);
+    ASSERT_FALSE(borrowed.IsContiguous());
+    borrowed(2, 2) = 'o';
+    ASSERT_EQ(borrowed(2, 2), 'o');
+
+    Grid borrowed_crlf(std::make_shared<MappedFile>("data/input_grid_crlf.txt"));
+    ASSERT_TRUE(borrowed_crlf == *grid);
+    ASSERT_EQ(borrowed_crlf.RowStride(), 5U);
+    borrowed_crlf.InsertRow(3, {'.', '.', '.'});
+    ASSERT_TRUE(borrowed_crlf.IsContiguous());
+    ASSERT_EQ(borrowed_crlf.NRows(), 4U);
+    ASSERT_EQ(borrowed_crlf(1, 1), 'x');
+
+    ThreadPool pool(2);
+    Grid gridpool(file, '\0', pool);
+    ASSERT_TRUE(gridpool == *grid);
+    ASSERT_THROW(Grid(MappedFile("data/input_grid_ragged.txt"), '\0', pool), std::length_error);
+
+    ASSERT_THROW(MappedFile("data/missing.txt"), std::ios_base::failure);
+    ASSERT_THROW(Grid(std::make_shared<MappedFile>("data/input_grid_ragged.txt")), std::length_error);
+    ASSERT_THROW(Grid(MappedFile("data/input_grid_ragged.txt"), '\0'), std::length_error);
+}
+
+TEST_F(GridTests, SnapshotTest)
+{
+    const std::string path{"data/snapshot_grid.bin"};
+    grid->AddTileTypeDefinition(TileType::kTileType_Wall, 'x');
+    grid->AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+    grid->AddActor(Actor(7, 'a', Position<std::size_t>(2, 1)));
+    grid->AddActor(Actor(9, 'b', Position<std::size_t>(0, 0)));
+    grid->MakeInfinite(true);
+    grid->SaveSnapshot(path);
+
+    Grid restored = Grid::LoadSnapshot(std::make_shared<MappedFile>(path));
+    ASSERT_TRUE(restored == *grid);
+    ASSERT_TRUE(restored.IsInfinite());
+    ASSERT_EQ(restored.GetTilesMap(), grid->GetTilesMap());
+    ASSERT_EQ(restored.GetTileType(1, 0), TileType::kTileType_Wall);
+    ASSERT_EQ(restored.ActorsAt(1, 2), std::vector<std::size_t>({7}));
+    ASSERT_EQ(restored.GetActors().size(), 2U);
+    ASSERT_EQ(restored(4, 3), 'x');
+
+    // Matrix<char> snapshots hold the same characters
+    ASSERT_TRUE(Matrix<char>::LoadSnapshot(std::make_shared<MappedFile>(path)) == *grid);
+    Matrix<char>(std::vector<std::vector<char>>({{'a', 'b'}})).SaveSnapshot(path);
+    Grid plain = Grid::LoadSnapshot(std::make_shared<MappedFile>(path));
+    ASSERT_EQ(plain.NCols(), 2U);
+    ASSERT_FALSE(plain.IsInfinite());
+    ASSERT_TRUE(plain.GetActors().empty());
+    std::remove(path.c_str());
+}
+
+TEST_F(GridTests, HashTest)
+{
+    Grid hashed(30U, 20U, '.');
+    Grid plain(30U, 20U, '.');
+    hashed.EnableHashing(true);
+    ASSERT_TRUE(hashed.IsHashing());
+    ASSERT_FALSE(plain.IsHashing());
+    ASSERT_EQ(hashed.Hash(), plain.Hash());
+
+    // Writes through operator() update the hash, a cell written back to its value leaves it unchanged
+    const std::uint64_t empty{hashed.Hash()};
+    for (std::size_t i{0U}; i < 200U; ++i)
+    {
+        hashed((i * 7U) % 30U, (i * 3U) % 20U) = static_cast<char>('a' + i % 5U);
+        plain((i * 7U) % 30U, (i * 3U) % 20U) = static_cast<char>('a' + i % 5U);
+        if (i % 13U == 0U)
+        {
+            ASSERT_EQ(hashed.Hash(), plain.Hash());
+        }
+    }
+    ASSERT_EQ(hashed.Hash(), plain.Hash());
+    ASSERT_NE(hashed.Hash(), empty);
+    const std::uint64_t written{hashed.Hash()};
+    const char value{hashed(4, 5)};
+    hashed(4, 5) = '#';
+    ASSERT_NE(hashed.Hash(), written);
+    hashed(4, 5) = value;
+    ASSERT_EQ(hashed.Hash(), written);
+
+    // Bulk writes and resizes rehash, even a double swap bringing the grid back to its first buffer
+    hashed.Fill('.');
+    ASSERT_EQ(hashed.Hash(), empty);
+    Matrix<char> back(30U, 20U, '.');
+    hashed.SwapData(back);
+    back.Fill('#');
+    hashed.SwapData(back);
+    ASSERT_EQ(hashed.Hash(), Grid(30U, 20U, '#').Hash());
+    hashed.Fill('.');
+    ASSERT_NE(Grid(20U, 30U, '.').Hash(), empty);
+    hashed.RemoveRow(0);
+    ASSERT_EQ(hashed.Hash(), Grid(29U, 20U, '.').Hash());
+}
+
+TEST_F(GridTests, ValueIndexTest)
+{
+    Grid big(40U, 50U, '.');
+    for (std::size_t cell{0U}; cell < 2000U; cell += 3U)
+        big(cell / 50U, cell % 50U) = '#';
+    auto scan = [&big](char value, std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1) {
+        std::size_t count{0U};
+        for (std::size_t r{r0}; r <= std::min<std::size_t>(r1, 39U); ++r)
+            for (std::size_t c{c0}; c <= std::min<std::size_t>(c1, 49U); ++c)
+                count += (big(r, c) == value);
+        return count;
+    };
+    ASSERT_EQ(big.CountInRectangle('#', 0, 0, 39, 49), 667U);
+
+    big.IndexValues({'#', '.', '#'});
+    ASSERT_TRUE(big.IsValueIndexed('#'));
+    ASSERT_FALSE(big.IsValueIndexed('o'));
+    ASSERT_EQ(big.CountInRectangle('#', 0, 0, 39, 49), 667U);
+    ASSERT_EQ(big.CountInRectangle('.', 5, 7, 100, 30), scan('.', 5, 7, 100, 30));
+    ASSERT_EQ(big.CountInRectangle('#', 10, 10, 5, 5), 0U);
+
+    // Writes through operator() are seen, before and after the planes are rebuilt
+    for (std::size_t i{0U}; i < 300U; ++i)
+    {
+        big((i * 7U) % 40U, (i * 11U) % 50U) = (i % 2U == 0U) ? 'o' : '#';
+        if (i % 37U == 0U)
+        {
+            ASSERT_EQ(big.CountInRectangle('#', 3, 4, 30, 40), scan('#', 3, 4, 30, 40));
+            ASSERT_EQ(big.CountInRectangle('o', 3, 4, 30, 40), scan('o', 3, 4, 30, 40));
+        }
+    }
+    ASSERT_EQ(big.CountInRectangle('.', 0, 0, 39, 49), scan('.', 0, 0, 39, 49));
+
+    // Bulk writes and resizes rebuild the index, even a double swap bringing the grid back to its first buffer
+    big.Fill('.');
+    ASSERT_EQ(big.CountInRectangle('.', 0, 0, 39, 49), 2000U);
+    Matrix<char> back(40U, 50U, '.');
+    big.SwapData(back);
+    back.Fill('#');
+    big.SwapData(back);
+    ASSERT_EQ(big.CountInRectangle('#', 0, 0, 39, 49), 2000U);
+    big.Fill('.');
+    big.InsertRow(0, std::vector<char>(50U, '#'));
+    ASSERT_EQ(big.CountInRectangle('#', 0, 0, 0, 49), 50U);
+    big.IndexValues({});
+    ASSERT_FALSE(big.IsValueIndexed('#'));
+    ASSERT_EQ(big.CountInRectangle('#', 0, 0, 40, 49), 50U);
+
+    // A query after every write: the writes are folded one by one, past the rebuild limit
+    Grid square(64U, 64U, '.');
+    square.IndexValues({'#', 'o'});
+    for (std::size_t i{0U}; i < 1000U; ++i)
+    {
+        const std::size_t row{(i * 37U) % 64U};
+        const std::size_t col{(i * 23U + i / 64U) % 64U};
+        square(row, col) = "#o."[i % 3U];
+        const std::size_t r0{i % 64U};
+        const std::size_t c0{(i * 5U) % 64U};
+        std::size_t expected{0U};
+        for (std::size_t r{r0}; r < 64U; ++r)
+            for (std::size_t c{c0}; c < 64U; ++c)
+                expected += (square(r, c) == '#');
+        ASSERT_EQ(square.CountInRectangle('#', r0, c0, 63U, 63U), expected);
+    }
+}
+
+TEST_F(GridTests, BulkScanTest)
+{
+    ASSERT_EQ(grid->CountElements('x'), 3U);
+    ASSERT_EQ(grid->Find('x'), std::make_pair(std::size_t{1}, std::size_t{0}));
+    ASSERT_FALSE(grid->Find('#').has_value());
+
+    // Borrowed grids are not contiguous (the newlines are part of the row stride)
+    Grid borrowed(std::make_shared<MappedFile>("data/input_grid.txt"));
+    std::vector<std::pair<std::size_t, std::size_t>> expected({{1, 0}, {1, 1}, {2, 1}});
+    ASSERT_EQ(borrowed.FindAll('x'), expected);
+    ASSERT_EQ(borrowed.Replace('x', '#'), 3U);
+    ASSERT_EQ(borrowed.CountElements('#'), 3U);
+    ASSERT_EQ(borrowed.CountElements('\n'), 0U);
+    borrowed.Fill('.');
+    ASSERT_EQ(borrowed.CountElements('.'), 9U);
+}
+
 TEST_F(GridTests, TilesTest)
 {
     grid->AddTileTypeDefinition(TileType::kTileType_Empty, '.');
@@ -42,6 +231,83 @@ TEST_F(GridTests, TilesTest)
     EXPECT_FALSE(res);
     res = grid->AddTileTypeDefinition(TileType::kTileType_Empty, 'x');
     EXPECT_FALSE(res);
+    res = grid->AddTileTypeDefinition(TileType::kTileType_Empty, 'y');
+    EXPECT_FALSE(res);
+    EXPECT_EQ(grid->GetTileType('y'), TileType::kTileType_Undefined);
+    EXPECT_EQ(grid->GetTileType('x'), TileType::kTileType_Wall);
+}
+
+TEST_F(GridTests, TilePlaneTest)
+{
+    grid->AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+    grid->AddTileTypeDefinition(TileType::kTileType_Wall, 'x');
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Wall), 3U);
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Undefined), 0U);
+    ASSERT_THROW(grid->TilePositions(TileType::kTileType_Wall), std::logic_error);
+
+    grid->MaterializeTiles(true);
+    ASSERT_TRUE(grid->HasTilePlane());
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Wall), 3U);
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Empty), 6U);
+    auto walls = grid->TilePositions(TileType::kTileType_Wall);
+    ASSERT_EQ(walls.size(), 3U);
+    ASSERT_NE(std::find(walls.begin(), walls.end(), Position<std::size_t>(1U, 2U)), walls.end());
+
+    // Writes are applied on the next query
+    (*grid)(1, 1) = '.';
+    (*grid)(0, 0) = 'x';
+    (*grid)(2, 2) = 'T';
+    (*grid)(2, 2) = 'T';
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Wall), 3U);
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Empty), 5U);
+    ASSERT_EQ(grid->TilePositions(TileType::kTileType_Undefined),
+              std::vector<Position<std::size_t>>({Position<std::size_t>(2U, 2U)}));
+
+    // New definitions, resizes and bulk writes rebuild the plane
+    grid->AddTileTypeDefinition(TileType::kTileType_Tree, 'T');
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Tree), 1U);
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Undefined), 0U);
+    grid->InsertRow(0U, std::vector<char>({'T', 'T', 'x'}));
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Tree), 3U);
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Wall), 4U);
+    grid->Replace('x', 'T');
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Tree), 7U);
+
+    // Swapping the storage back and forth is a bulk write too, even if the grid ends up on its first buffer
+    Grid swapped(4, 4, '.');
+    swapped.AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+    swapped.AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+    swapped.MaterializeTiles(true);
+    ASSERT_EQ(swapped.CountTiles(TileType::kTileType_Empty), 16U);
+    Matrix<char> back(4, 4, '#');
+    swapped.SwapData(back);
+    back.Fill('#');
+    swapped.SwapData(back);
+    ASSERT_EQ(swapped.CountTiles(TileType::kTileType_Wall), 16U);
+    swapped.Fill('.');
+    ASSERT_EQ(swapped.CountTiles(TileType::kTileType_Empty), 16U);
+
+    // Random writes, checked against full scans
+    Grid big(30, 40, '.');
+    big.AddTileTypeDefinition(TileType::kTileType_Empty, '.');
+    big.AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+    big.MaterializeTiles(true);
+    const char values[] = {'.', '#', '?'};
+    for (std::size_t i{0U}; i < 5000U; ++i)
+    {
+        big((i * 7919U) % 30U, (i * 104729U) % 40U) = values[(i * 31U) % 3U];
+        if (i % 500U == 0U)
+        {
+            ASSERT_EQ(big.CountTiles(TileType::kTileType_Wall), big.CountElements('#'));
+            ASSERT_EQ(big.CountTiles(TileType::kTileType_Undefined), big.CountElements('?'));
+            for (const auto& position : big.TilePositions(TileType::kTileType_Empty))
+                ASSERT_EQ(std::as_const(big)(position.y, position.x), '.');
+        }
+    }
+
+    grid->MaterializeTiles(false);
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Tree), 7U);
+    ASSERT_EQ(grid->CountTiles(TileType::kTileType_Undefined), 0U);
 }
 
 TEST_F(GridTests, InfiniteTest)
@@ -51,7 +317,7 @@ TEST_F(GridTests, InfiniteTest)
     grid->MakeInfinite(false);
     try
     {
-        char tile = grid->operator()(10, 10);
+        grid->operator()(10, 10);
     }
     catch (const std::exception& e)
     {
@@ -59,6 +325,116 @@ TEST_F(GridTests, InfiniteTest)
     }
 }
 
+TEST_F(GridTests, ChangeTrackingTest)
+{
+    using Cells = std::vector<std::pair<std::size_t, std::size_t>>;
+    Grid big(6, 6, '.');
+    ASSERT_FALSE(big.IsFixedPoint());
+    big.TrackChanges(true);
+    ASSERT_TRUE(big.AllCellsActive());
+    ASSERT_EQ(big.ActiveCells().size(), 36U);
+
+    big(2, 3) = '#';
+    big(2, 3) = '#';
+    big(4, 4) = '.';  // Written, but unchanged
+    ASSERT_EQ(big.CommitChanges(), 1U);
+    ASSERT_FALSE(big.AllCellsActive());
+    ASSERT_EQ(big.ChangedCells(), Cells({{2, 3}}));
+    ASSERT_EQ(big.ActiveCells(0U), Cells({{2, 3}}));
+    ASSERT_EQ(big.ActiveCells(1U).size(), 9U);
+
+    // Written and restored within the same step
+    big(0, 0) = '#';
+    big(0, 0) = '.';
+    big(5, 5) = '#';
+    ASSERT_EQ(big.CommitChanges(), 1U);
+    ASSERT_EQ(big.ActiveCells(1U).size(), 4U);
+    ASSERT_EQ(big.ActiveCells(1U, true).size(), 9U);
+    ASSERT_FALSE(big.IsFixedPoint());
+
+    // Reads do not count as writes, through the non-const operator() too
+    const Grid& cbig = big;
+    ASSERT_EQ(cbig(5, 5), '#');
+    std::size_t walls{0U};
+    for (std::size_t cell{0U}; cell < 36U; ++cell)
+        walls += (big(cell / 6U, cell % 6U) == '#');
+    ASSERT_EQ(walls, 2U);
+    ASSERT_EQ(big.ActiveCells(0U), Cells({{5, 5}}));
+    big.AddTileTypeDefinition(TileType::kTileType_Wall, '#');
+    ASSERT_EQ(big.GetTileType(5, 5), TileType::kTileType_Wall);
+    ASSERT_EQ(big.CommitChanges(), 0U);
+    ASSERT_TRUE(big.IsFixedPoint());
+
+    big.InsertRow(0U, std::vector<char>(6U, '.'));
+    ASSERT_EQ(big.CommitChanges(), 42U);
+    ASSERT_TRUE(big.AllCellsActive());
+    big.TrackChanges(false);
+    ASSERT_FALSE(big.IsFixedPoint());
+}
+
+TEST_F(GridTests, CellRefTest)
+{
+    using Cells = std::vector<std::pair<std::size_t, std::size_t>>;
+    static_assert(std::is_same_v<Grid::CellRef::value_type, char>);
+    Grid cells(2, 3, 'a');
+    Grid plain(2, 3, 'a');
+    cells.TrackChanges(true);
+    cells.EnableHashing(true);
+    cells.CommitChanges();
+
+    // Compound assignments and increments are logged as writes
+    cells(0, 0) += 2;
+    ASSERT_EQ(cells(0, 0), 'c');
+    cells(0, 0) -= 1;
+    ASSERT_EQ(cells(0, 0), 'b');
+    ASSERT_EQ(++cells(0, 1), 'b');
+    ASSERT_EQ(cells(0, 2)++, 'a');
+    ASSERT_EQ(cells(0, 2), 'b');
+    ASSERT_EQ(--cells(0, 2), 'a');
+    ASSERT_EQ(cells(0, 2)--, 'a');
+    cells(1, 0) |= 0x20;
+    cells(1, 0) ^= 0x03;
+    ASSERT_EQ(cells(1, 0), 'b');
+    cells(1, 1) &= 0x60;
+    cells(1, 1) >>= 1;
+    cells(1, 1) <<= 1;
+    ASSERT_EQ(cells(1, 1), '`');
+    cells(1, 1) *= 1;
+    cells(1, 1) /= 1;
+    cells(1, 1) %= 100;
+    ASSERT_EQ(cells(1, 1), '`');
+    ASSERT_EQ(cells.CommitChanges(), 5U);
+    ASSERT_EQ(cells.ChangedCells(), Cells({{0, 0}, {0, 1}, {0, 2}, {1, 0}, {1, 1}}));
+
+    // Swaps through argument-dependent lookup, between two cells or a cell and a char
+    using std::swap;
+    swap(cells(0, 0), cells(1, 2));
+    ASSERT_EQ(cells(0, 0), 'a');
+    ASSERT_EQ(cells(1, 2), 'b');
+    char value{'z'};
+    swap(cells(1, 2), value);
+    ASSERT_EQ(cells(1, 2), 'z');
+    ASSERT_EQ(value, 'b');
+    swap(value, cells(1, 2));
+    ASSERT_EQ(cells(1, 2), 'b');
+    ASSERT_EQ(cells.CommitChanges(), 2U);
+
+    // The hash followed every write
+    plain.Fill('a');
+    plain(0, 1) = 'b';
+    plain(0, 2) = '`';
+    plain(1, 0) = 'b';
+    plain(1, 1) = '`';
+    plain(1, 2) = 'b';
+    ASSERT_TRUE(cells == plain);
+    ASSERT_EQ(cells.Hash(), plain.Hash());
+
+    // A copied value is detached from the grid
+    const char copy = cells(0, 0);
+    cells(0, 0) = '#';
+    ASSERT_EQ(copy, 'a');
+}
+
 TEST_F(GridTests, ActorsTest)
 {
     Actor actor_1(0U, 'x');
@@ -72,3 +448,90 @@ TEST_F(GridTests, ActorsTest)
     grid->GetActor(1U, res);
     EXPECT_EQ(res.GetCharacter(), 'y');
 }
+
+TEST_F(GridTests, ActorsSpatialIndexTest)
+{
+    Grid big(20, 30, '.');
+    for (std::size_t id{0U}; id < 100U; ++id)
+        ASSERT_TRUE(big.AddActor(Actor(id, 'a', Position<std::size_t>(id % 30U, id / 30U))));
+    ASSERT_TRUE(big.AddActor(Actor(100U, 'b', Position<std::size_t>(5U, 0U))));
+    ASSERT_FALSE(big.AddActor(Actor(100U, 'b')));
+    ASSERT_THROW(big.AddActor(Actor(101U, 'c', Position<std::size_t>(30U, 0U))), std::out_of_range);
+    ASSERT_TRUE(big.ActorExists(42U));
+
+    ASSERT_TRUE(big.IsOccupied(3, 9));
+    ASSERT_FALSE(big.IsOccupied(3, 10));
+    auto at = big.ActorsAt(0, 5);
+    std::sort(at.begin(), at.end());
+    ASSERT_EQ(at, std::vector<std::size_t>({5U, 100U}));
+    ASSERT_EQ(big.ActorsInRectangle(1, 0, 2, 29).size(), 60U);
+    ASSERT_EQ(big.ActorsInRectangle(3, 8, 100, 100).size(), 2U);
+    ASSERT_EQ(big.ActorsInRadius(1, 1, 1.0).size(), 5U);
+    ASSERT_EQ(big.ActorsInRadius(1, 1, 1.5).size(), 9U);
+
+    // Moves and removals
+    ASSERT_TRUE(big.MoveActor(100U, Position<std::size_t>(10U, 10U)));
+    ASSERT_EQ(big.ActorsAt(0, 5), std::vector<std::size_t>({5U}));
+    ASSERT_EQ(big.ActorsAt(10, 10), std::vector<std::size_t>({100U}));
+    Actor moved;
+    big.GetActor(100U, moved);
+    ASSERT_EQ(moved.GetPosition(), Position<std::size_t>(10U, 10U));
+    ASSERT_TRUE(big.RemoveActor(5U));
+    ASSERT_FALSE(big.RemoveActor(5U));
+    ASSERT_FALSE(big.IsOccupied(0, 5));
+    ASSERT_FALSE(big.MoveActor(5U, Position<std::size_t>(0U, 0U)));
+    ASSERT_TRUE(big.AddActor(Actor(5U, 'a', Position<std::size_t>(1U, 1U))));
+    ASSERT_EQ(big.ActorsAt(1, 1).size(), 2U);
+
+    // Infinite grids wrap the positions, resizing rebuilds the index
+    big.MakeInfinite(true);
+    ASSERT_TRUE(big.MoveActor(100U, Position<std::size_t>(31U, 22U)));
+    ASSERT_EQ(big.ActorsAt(2, 1).size(), 2U);
+    big.GetActor(100U, moved);
+    ASSERT_EQ(moved.GetPosition(), Position<std::size_t>(1U, 2U));
+    big.InsertRow(20U, std::vector<char>(30U, '.'));
+    ASSERT_EQ(big.ActorsAt(1, 1).size(), 2U);
+    ASSERT_EQ(big.ActorsInRectangle(0, 0, 20, 29).size(), 101U);
+}
+
+TEST_F(GridTests, ActorsStructuralEditsTest)
+{
+    Grid small(3, 3, '.');
+    ASSERT_TRUE(small.AddActor(Actor(0U, 'a', Position<std::size_t>(0U, 0U))));
+    ASSERT_TRUE(small.AddActor(Actor(1U, 'b', Position<std::size_t>(1U, 1U))));
+    ASSERT_TRUE(small.AddActor(Actor(2U, 'c', Position<std::size_t>(2U, 2U))));
+    ASSERT_TRUE(small.IsOccupied(2, 2));
+
+    // The actors on a removed row are removed, the ones below move up
+    small.RemoveRow(1);
+    ASSERT_FALSE(small.ActorExists(1U));
+    ASSERT_EQ(small.ActorsAt(1, 2), std::vector<std::size_t>({2U}));
+    ASSERT_FALSE(small.IsOccupied(1, 1));
+    Actor moved;
+    small.GetActor(2U, moved);
+    ASSERT_EQ(moved.GetPosition(), Position<std::size_t>(2U, 1U));
+
+    // Inserted rows and columns push the actors after them
+    small.InsertRow(0, std::vector<char>(3U, '.'));
+    small.InsertColumn(1, std::vector<char>(3U, '.'));
+    ASSERT_EQ(small.ActorsAt(1, 0), std::vector<std::size_t>({0U}));
+    ASSERT_EQ(small.ActorsAt(2, 3), std::vector<std::size_t>({2U}));
+    small.RemoveColumn(3);
+    ASSERT_FALSE(small.ActorExists(2U));
+    ASSERT_EQ(small.ActorsInRectangle(0, 0, 2, 2), std::vector<std::size_t>({0U}));
+
+    // Batched edits: indices refer to the grid before the edits
+    ASSERT_TRUE(small.AddActor(Actor(3U, 'd', Position<std::size_t>(2U, 2U))));
+    small.ApplyEdits(MatrixEdits<char>().RemoveRow(0).InsertColumn(0, std::vector<char>(2U, '.')).RemoveColumn(1));
+    ASSERT_EQ(small.ActorsAt(0, 1), std::vector<std::size_t>({0U}));
+    ASSERT_EQ(small.ActorsAt(1, 2), std::vector<std::size_t>({3U}));
+    ASSERT_EQ(small.NRows(), 2U);
+    ASSERT_EQ(small.NCols(), 3U);
+
+    // The last row or column cannot be removed: the grid and its actors are left untouched
+    Grid line(1, 2, '.');
+    ASSERT_TRUE(line.AddActor(Actor(0U, 'a', Position<std::size_t>(1U, 0U))));
+    ASSERT_THROW(line.RemoveRow(0), std::length_error);
+    ASSERT_EQ(line.NRows(), 1U);
+    ASSERT_EQ(line.ActorsAt(0, 1), std::vector<std::size_t>({0U}));
+}
@@ -1,6 +1,10 @@
 /// @file data_structures_matrix_test.cpp
 /// @test commonlib::Matrix
 
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
 #include <iostream>
 #include <string>
 #include <vector>
@@ -36,6 +40,59 @@ TEST_F(IntMatrixTests, AccessTests)
     ASSERT_EQ(matrix->operator()(0, 0), 1);
 }
 
+TEST_F(IntMatrixTests, StorageTests)
+{
+    ASSERT_TRUE(matrix->IsContiguous());
+    ASSERT_EQ(matrix->RowStride(), 3U);
+    ASSERT_EQ(matrix->ColStride(), 1U);
+    const int* data = matrix->data();
+    for (std::size_t i{0U}; i < 6U; ++i)
+        ASSERT_EQ(data[i], int(i) + 1);
+
+    matrix->InsertRow(0, {7, 8, 9});
+    matrix->InsertColumn(3, {10, 11, 12});
+    ASSERT_EQ(matrix->RowStride(), 4U);
+    ASSERT_EQ(matrix->data()[1 * matrix->RowStride() + 3], 11);
+
+    Matrix<int> copy(*matrix);
+    copy(0, 0) = 0;
+    ASSERT_EQ(matrix->operator()(0, 0), 7);
+}
+
+TEST_F(IntMatrixTests, ViewTests)
+{
+    auto column = matrix->Column(1);
+    ASSERT_EQ(column.size(), 2U);
+    column[1] = 50;
+    ASSERT_EQ(matrix->operator()(1, 1), 50);
+    ASSERT_EQ(column, std::vector<int>({2, 50}));
+
+    auto sub = matrix->SubView(0, 1, 2, 2);
+    IntMatrixData expected_sub({{2, 3}, {50, 6}});
+    ASSERT_EQ(sub, expected_sub);
+    ASSERT_FALSE(sub.IsContiguous());
+    sub(1, 1) = 60;
+    ASSERT_EQ(matrix->operator()(1, 2), 60);
+    ASSERT_EQ(sub.Column(0), matrix->Column(1));
+
+    int sum{0};
+    for (const auto& row : matrix->View())
+        for (const auto& value : row)
+            sum += value;
+    ASSERT_EQ(sum, 1 + 2 + 3 + 4 + 50 + 60);
+
+    Matrix<int> other(*matrix);
+    ASSERT_TRUE(other == *matrix);
+    other(0, 0) = 0;
+    ASSERT_TRUE(other != *matrix);
+
+    matrix->InsertRow(0, matrix->Row(1));
+    matrix->InsertColumn(0, matrix->Column(2));
+    IntMatrixData expected_data({{60, 4, 50, 60}, {3, 1, 2, 3}, {60, 4, 50, 60}});
+    ASSERT_EQ(matrix->Data(), expected_data);
+    ASSERT_THROW(matrix->SubView(2, 2, 2, 2), std::out_of_range);
+}
+
 TEST_F(IntMatrixTests, EditTests)
 {
     matrix->operator()(0, 0) = 9;
@@ -55,6 +112,122 @@ TEST_F(IntMatrixTests, EditTests)
     ASSERT_EQ(matrix->operator()(1, 3), 9);
 }
 
+TEST_F(IntMatrixTests, BoundsCheckTests)
+{
+    ASSERT_THROW((*matrix)(2, 0), std::out_of_range);
+    ASSERT_EQ((*matrix)[1][2], 6);
+    (*matrix)[0][1] = 20;
+    ASSERT_EQ((*matrix)(0, 1), 20);
+
+    Matrix<int, BoundsUnchecked> unchecked({{1, 2, 3}, {4, 5, 6}});
+    unchecked.InsertRow(2, {7, 8, 9});
+    unchecked.Tile(1, 2);
+    ASSERT_EQ(unchecked(2, 4), 8);
+    ASSERT_EQ(unchecked[2][5], 9);
+    ASSERT_TRUE(unchecked.CutWindow(0, 0, 3) == (Matrix<int, BoundsUnchecked>({{0, 0, 0}, {0, 1, 2}, {0, 4, 5}})));
+
+    const Matrix<int, BoundsChecked> checked(IntMatrixData({{1, 2}}));
+    ASSERT_THROW(checked(0, 2), std::out_of_range);
+#ifndef NDEBUG
+    const Matrix<int, BoundsAsserted> asserted(IntMatrixData({{1, 2}}));
+    ASSERT_EQ(asserted(0, 1), 2);
+    ASSERT_DEATH(asserted(1, 0), "");
+#endif
+}
+
+TEST_F(IntMatrixTests, RemovalTests)
+{
+    Matrix<int> removed(*matrix);
+    removed.RemoveColumn(1);
+    ASSERT_EQ(removed.Data(), IntMatrixData({{1, 3}, {4, 6}}));
+    removed.RemoveRow(0);
+    ASSERT_EQ(removed.Data(), IntMatrixData({{4, 6}}));
+    ASSERT_THROW(removed.RemoveRow(1), std::out_of_range);
+    ASSERT_THROW(removed.RemoveColumn(2), std::out_of_range);
+    ASSERT_THROW(removed.RemoveRow(0), std::length_error);
+    ASSERT_THROW(removed.ApplyEdits(MatrixEdits<int>().RemoveRow(0)), std::length_error);
+    ASSERT_EQ(removed.Data(), IntMatrixData({{4, 6}}));
+    removed.InsertRow(0, {7, 8});
+    ASSERT_EQ(removed.Data(), IntMatrixData({{7, 8}, {4, 6}}));
+
+    // Removing from a strided region
+    Matrix<int> big({{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}});
+    big.RemoveRow(1);
+    big.RemoveColumn(0);
+    big.RemoveColumn(2);
+    ASSERT_EQ(big.Data(), IntMatrixData({{2, 3}, {10, 11}}));
+
+    Matrix<int> column(IntMatrixData({{1}, {2}}));
+    ASSERT_THROW(column.RemoveColumn(0), std::length_error);
+    ASSERT_EQ(column.Data(), IntMatrixData({{1}, {2}}));
+}
+
+TEST_F(IntMatrixTests, BatchedEditsTests)
+{
+    Matrix<int> edited(*matrix);
+    MatrixEdits<int> edits;
+    edits.RemoveRow(0).InsertRow(2, {7, 8, 9}).InsertRow(0, {0, 0, 0}).RemoveColumn(1).RemoveColumn(2).RemoveColumn(1);
+    edits.InsertColumn(3, {10, 11, 12}).InsertColumn(0, {-1, -2, -3});
+    edited.ApplyEdits(edits);
+    ASSERT_EQ(edited.Data(), IntMatrixData({{0, 0, 0}, {-2, 4, 11}, {7, 8, 9}}));
+    ASSERT_FALSE(edits.Empty());
+    edits.Clear();
+    ASSERT_TRUE(edits.Empty());
+    edited.ApplyEdits(edits);
+    ASSERT_EQ(edited.NRows(), 3U);
+
+    ASSERT_THROW(edited.ApplyEdits(MatrixEdits<int>().RemoveRow(3)), std::out_of_range);
+    ASSERT_THROW(edited.ApplyEdits(MatrixEdits<int>().InsertColumn(5, {1, 2, 3})), std::out_of_range);
+    ASSERT_THROW(edited.ApplyEdits(MatrixEdits<int>().InsertRow(0, {1, 2})), std::length_error);
+
+    // Many edits, matching the one-by-one result
+    Matrix<int> one_by_one(*matrix);
+    MatrixEdits<int> inserts;
+    for (int i{0}; i < 100; ++i)
+    {
+        one_by_one.InsertRow(one_by_one.NRows(), {i, i, i});
+        inserts.InsertRow(2, {i, i, i});
+    }
+    Matrix<int> batched(*matrix);
+    batched.ApplyEdits(inserts);
+    ASSERT_EQ(batched.Data(), one_by_one.Data());
+}
+
+TEST_F(IntMatrixTests, TilingTests)
+{
+    Matrix<int> propagated(*matrix);
+    propagated.PropagateHorizontally(2);
+    ASSERT_EQ(propagated.Data(), IntMatrixData({{1, 2, 3, 1, 2, 3, 1, 2, 3}, {4, 5, 6, 4, 5, 6, 4, 5, 6}}));
+    propagated.PropagateHorizontally(0);
+    ASSERT_EQ(propagated.NCols(), 9U);
+
+    Matrix<int> stacked(*matrix);
+    stacked.PropagateVertically(1);
+    ASSERT_EQ(stacked.Data(), IntMatrixData({{1, 2, 3}, {4, 5, 6}, {1, 2, 3}, {4, 5, 6}}));
+
+    // Tiling a strided region
+    Matrix<int> tiled(matrix->SubView(0, 1, 2, 2).ToVector());
+    tiled.Tile(3, 2);
+    ASSERT_EQ(tiled.NRows(), 6U);
+    ASSERT_EQ(tiled.NCols(), 4U);
+    ASSERT_EQ(tiled.Row(5), std::vector<int>({5, 6, 5, 6}));
+    ASSERT_THROW(tiled.Tile(0, 1), std::length_error);
+
+    // Lazy view, equal to the materialized tiling
+    Matrix<int> big(*matrix);
+    big.Tile(100, 100);
+    const TiledView<int> view = matrix->Tiled(100, 100);
+    ASSERT_EQ(view.NRows(), 200U);
+    ASSERT_EQ(view.NCols(), 300U);
+    ASSERT_EQ(view(199, 299), 6);
+    ASSERT_EQ(view.at(101, 3), 4);
+    ASSERT_THROW(view.at(200, 0), std::out_of_range);
+    ASSERT_EQ(big.Data(), view.ToVector());
+    ASSERT_EQ(view.BaseRow(3), std::vector<int>({4, 5, 6}));
+    const TiledView<int> partial(matrix->View(), 3, 4);
+    ASSERT_EQ(partial.ToVector(), IntMatrixData({{1, 2, 3, 1}, {4, 5, 6, 4}, {1, 2, 3, 1}}));
+}
+
 TEST_F(IntMatrixTests, PropertiesTest)
 {
     ASSERT_FALSE(matrix->IsSquare());
@@ -78,6 +251,96 @@ TEST_F(IntMatrixTests, FileLoadingTest)
 
     fp.close();
     fp_flat.close();
+
+    Matrix<int> matmf(MappedFile("data/input_matrix.txt"));
+    ASSERT_TRUE(matmf == *matrix);
+    Matrix<int> matmf_flat(MappedFile("data/input_matrix_flat.txt"), 2, 3);
+    ASSERT_TRUE(matmf_flat == *matrix);
+    ASSERT_THROW(Matrix<int>(MappedFile("data/input_matrix_flat.txt"), 3, 3), std::length_error);
+
+    try
+    {
+        Matrix<int> malformed(MappedFile("data/input_matrix_malformed.txt"));
+        FAIL();
+    }
+    catch (const ParseError& e)
+    {
+        EXPECT_EQ(e.Row(), 1U);
+        EXPECT_EQ(e.Column(), 1U);
+    }
+}
+
+TEST_F(IntMatrixTests, SnapshotTest)
+{
+    const std::string path{"data/snapshot_matrix.bin"};
+    matrix->SaveSnapshot(path);
+    Matrix<int> restored = Matrix<int>::LoadSnapshot(std::make_shared<MappedFile>(path));
+    ASSERT_TRUE(restored == *matrix);
+    restored(1, 1) = 50;
+    ASSERT_EQ(Matrix<int>::LoadSnapshot(std::make_shared<MappedFile>(path))(1, 1), 5);
+    restored.InsertRow(2, {7, 8, 9});
+    ASSERT_EQ(restored.Row(1), std::vector<int>({4, 50, 6}));
+
+    // Strided storage is written unpadded
+    Matrix<double> strided({{0.5, 1.5, 2.5}, {3.5, 4.5, 5.5}});
+    strided.RemoveColumn(0);
+    strided.SaveSnapshot(path);
+    ASSERT_EQ(Matrix<double>::LoadSnapshot(std::make_shared<MappedFile>(path)).Data(),
+              std::vector<std::vector<double>>({{1.5, 2.5}, {4.5, 5.5}}));
+    ASSERT_THROW(Matrix<int>::LoadSnapshot(std::make_shared<MappedFile>(path)), std::invalid_argument);
+    ASSERT_THROW(Matrix<int>::LoadSnapshot(std::make_shared<MappedFile>("data/input_matrix.txt")),
+                 std::invalid_argument);
+
+    // Corrupted elements are detected by the checksum
+    {
+        std::fstream fp(path, std::ios::in | std::ios::out | std::ios::binary);
+        fp.seekp(sizeof(SnapshotHeader) + 3U);
+        fp.put('\x7f');
+    }
+    ASSERT_THROW(Matrix<double>::LoadSnapshot(std::make_shared<MappedFile>(path)), std::invalid_argument);
+    ASSERT_NO_THROW(Matrix<double>::LoadSnapshot(std::make_shared<MappedFile>(path), false));
+
+    // Headers recording 0 rows or 0 columns are rejected like the constructors reject them
+    for (const std::size_t field : {offsetof(SnapshotHeader, n_rows), offsetof(SnapshotHeader, n_cols)})
+    {
+        matrix->SaveSnapshot(path);
+        {
+            const std::uint64_t zero{0U};
+            std::fstream fp(path, std::ios::in | std::ios::out | std::ios::binary);
+            fp.seekp(field);
+            fp.write(reinterpret_cast<const char*>(&zero), sizeof(zero));
+        }
+        ASSERT_THROW(Matrix<int>::LoadSnapshot(std::make_shared<MappedFile>(path)), std::length_error);
+    }
+    std::remove(path.c_str());
+}
+
+TEST_F(IntMatrixTests, ParallelFileLoadingTest)
+{
+    ThreadPool pool(4);
+    MappedFile file("data/input_matrix_big.txt");
+    Matrix<int> serial(file);
+    Matrix<int> parallel(file, ',', pool);
+    ASSERT_EQ(parallel.NRows(), 64U);
+    ASSERT_EQ(parallel.NCols(), 32U);
+    ASSERT_EQ(parallel(63, 31), 6331);
+    ASSERT_TRUE(parallel == serial);
+
+    std::ifstream fp;
+    fp.open("data/input_matrix.txt", std::ifstream::in);
+    Matrix<int> small(fp, ',', pool);
+    ASSERT_TRUE(small == *matrix);
+
+    try
+    {
+        Matrix<int> malformed(MappedFile("data/input_matrix_malformed.txt"), ',', pool);
+        FAIL();
+    }
+    catch (const ParseError& e)
+    {
+        EXPECT_EQ(e.Row(), 1U);
+        EXPECT_EQ(e.Column(), 1U);
+    }
 }
 
 TEST_F(IntMatrixTests, NeighboursTests)
@@ -104,6 +367,48 @@ TEST_F(IntMatrixTests, NeighboursTests)
     auto sub4_99 = big_mat.CutWindow(3U, 3U, 3U, 99);
     IntMatrixData expected_data4_99({{13, 14, 15}, {18, 19, 20}, {99, 99, 99}});
     ASSERT_EQ(sub4_99.Data(), expected_data4_99);
+
+    // Fixed-size windows, equal to the dynamic ones
+    const FixedMatrix<int, 3, 3> fixed2 = big_mat.CutWindow<3>(1U, 1U);
+    ASSERT_EQ(fixed2.Data(), expected_data2);
+    ASSERT_EQ(big_mat.CutWindow<3>(0U, 0U).Data(), expected_data3);
+    ASSERT_EQ(big_mat.CutWindow<3>(3U, 3U, 99).Data(), expected_data4_99);
+    ASSERT_EQ(big_mat.CutWindow<1>(2U, 4U)(0, 0), 15);
+    ASSERT_EQ(big_mat.CutWindow<5>(2U, 2U).Data(),
+              IntMatrixData({{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}, {11, 12, 13, 14, 15}, {16, 17, 18, 19, 20}, {0, 0, 0, 0, 0}}));
+    ASSERT_EQ(big_mat.CutWindow<7>(3U, 4U, -1).CountElements(-1), 49U - 16U);
+}
+
+TEST_F(IntMatrixTests, SlidingWindowTests)
+{
+    Matrix<int> big_mat({{1, 2, 3, 4, 5}, {6, 7, 8, 9, 10}, {11, 12, 13, 14, 15}, {16, 17, 18, 19, 20}});
+
+    std::size_t n_windows{0U};
+    big_mat.ForEachWindow(3U, [&](std::size_t row, std::size_t col, MatrixView<const int> window) {
+        ASSERT_EQ(window.NRows(), 3U);
+        ASSERT_EQ(window, big_mat.CutWindow(row, col, 3U, -1).Data());
+        ++n_windows;
+    }, -1);
+    ASSERT_EQ(n_windows, 20U);
+
+    // Windows larger than the matrix, on several threads
+    ThreadPool pool(3);
+    Matrix<int> sums(4U, 5U, 0);
+    big_mat.ForEachWindow(5U, [&](std::size_t row, std::size_t col, MatrixView<const int> window) {
+        ASSERT_EQ(window, big_mat.CutWindow<5>(row, col).Data());
+        for (const auto& window_row : window)
+            for (const int value : window_row)
+                sums(row, col) += value;
+    }, 0, &pool);
+    ASSERT_EQ(sums(0, 0), 1 + 2 + 3 + 6 + 7 + 8 + 11 + 12 + 13);
+    ASSERT_EQ(sums(3, 4), 8 + 9 + 10 + 13 + 14 + 15 + 18 + 19 + 20);
+
+    std::size_t n_single{0U};
+    big_mat.ForEachWindow(1U, [&](std::size_t row, std::size_t col, MatrixView<const int> window) {
+        n_single += (window(0, 0) == big_mat(row, col));
+    });
+    ASSERT_EQ(n_single, 20U);
+    ASSERT_THROW(big_mat.ForEachWindow(2U, [](std::size_t, std::size_t, MatrixView<const int>) {}), std::out_of_range);
 }
 
 // TODO TEST_F(IntMatrixTests, ExceptionsTest)
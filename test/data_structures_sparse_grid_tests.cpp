@@ -0,0 +1,137 @@
+/// @file data_structures_sparse_grid_tests.cpp
+/// @test commonlib::SparseGrid
+
+#include <limits>
+#include <map>
+#include <random>
+#include <utility>
+
+#include <data_structures/sparse_grid.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+TEST(SparseGridTests, AccessTest)
+{
+    SparseGrid<char, 8U> grid('.');
+    ASSERT_TRUE(grid.Empty());
+    ASSERT_FALSE(grid.GetBoundingBox().has_value());
+    ASSERT_EQ(grid.Get(-1000, 1000000), '.');
+    grid.Set(5, 5, '.');
+    ASSERT_EQ(grid.NChunks(), 0U);
+
+    grid.Set(-1, -1, '#');
+    grid.Set(-8, 7, '#');
+    grid.Set(-9, 8, '#');
+    grid.Set(100, -100, 'x');
+    ASSERT_EQ(grid(-1, -1), '#');
+    ASSERT_EQ(grid(-9, 8), '#');
+    ASSERT_EQ(grid(100, -100), 'x');
+    ASSERT_EQ(grid(-2, -1), '.');
+    ASSERT_EQ(grid.NChunks(), 4U);
+    ASSERT_EQ(grid.NFilled(), 4U);
+    ASSERT_EQ(grid.GetBoundingBox(), (BoundingBox{-9, -100, 100, 8}));
+
+    ASSERT_EQ(grid.CountElements('#'), 3U);
+    ASSERT_EQ(grid.CountElements('x'), 1U);
+    ASSERT_EQ(grid.CountElements('.'), 110U * 109U - 4U);
+
+    // Clearing releases the chunk and shrinks the box
+    grid.Set(100, -100, '.');
+    ASSERT_EQ(grid.NChunks(), 3U);
+    ASSERT_EQ(grid.GetBoundingBox(), (BoundingBox{-9, -1, -1, 8}));
+    grid.Set(-9, 8, '#');
+    ASSERT_EQ(grid.NFilled(), 3U);
+
+    const Matrix<char> dense = grid.ToMatrix();
+    ASSERT_EQ(dense.NRows(), 9U);
+    ASSERT_EQ(dense.NCols(), 10U);
+    ASSERT_EQ(dense(0, 9), '#');
+    ASSERT_EQ(dense(1, 8), '#');
+    ASSERT_EQ(dense(8, 0), '#');
+    ASSERT_EQ(dense.CountElements('#'), 3U);
+
+    grid.Clear();
+    ASSERT_TRUE(grid.Empty());
+    ASSERT_THROW(grid.ToMatrix(), std::length_error);
+}
+
+TEST(SparseGridTests, DistantCellsTest)
+{
+    // Chunks 2^32 chunks apart do not alias, the whole long range is usable
+    SparseGrid<char, 8U> grid('.');
+    const long far{1L << 35};
+    grid.Set(0, 0, 'a');
+    grid.Set(far, 0, 'b');
+    grid.Set(0, -far, 'c');
+    grid.Set(std::numeric_limits<long>::min(), std::numeric_limits<long>::max(), 'd');
+    ASSERT_EQ(grid.NChunks(), 4U);
+    ASSERT_EQ(grid(0, 0), 'a');
+    ASSERT_EQ(grid(far, 0), 'b');
+    ASSERT_EQ(grid(0, -far), 'c');
+    ASSERT_EQ(grid(std::numeric_limits<long>::min(), std::numeric_limits<long>::max()), 'd');
+    ASSERT_EQ(grid(-far, 0), '.');
+    ASSERT_EQ(grid.GetBoundingBox(),
+              (BoundingBox{std::numeric_limits<long>::min(), -far, far, std::numeric_limits<long>::max()}));
+    grid.Set(far, 0, '.');
+    ASSERT_EQ(grid.NChunks(), 3U);
+    ASSERT_EQ(grid(0, 0), 'a');
+}
+
+TEST(SparseGridTests, RandomTest)
+{
+    // Compare with a std::map reference
+    std::mt19937 rng(7U);
+    SparseGrid<int, 16U> grid(0);
+    std::map<std::pair<long, long>, int> reference;
+    for (int i{0}; i < 20000; ++i)
+    {
+        const long row{long(rng() % 200U) - 100};
+        const long col{long(rng() % 200U) - 100};
+        const int value{int(rng() % 3U)};
+        grid.Set(row, col, value);
+        if (value == 0)
+            reference.erase({row, col});
+        else
+            reference[{row, col}] = value;
+        if (i % 1000 == 0)
+        {
+            ASSERT_EQ(grid.NFilled(), reference.size());
+            long min_row{1000}, max_row{-1000}, min_col{1000}, max_col{-1000};
+            for (const auto& [cell, v] : reference)
+            {
+                min_row = std::min(min_row, cell.first);
+                max_row = std::max(max_row, cell.first);
+                min_col = std::min(min_col, cell.second);
+                max_col = std::max(max_col, cell.second);
+            }
+            ASSERT_EQ(grid.GetBoundingBox(), (BoundingBox{min_row, min_col, max_row, max_col}));
+        }
+    }
+    std::size_t ones{0U};
+    for (const auto& [cell, value] : reference)
+        ones += (value == 1) ? 1U : 0U;
+    ASSERT_EQ(grid.CountElements(1), ones);
+
+    std::size_t visited{0U};
+    grid.ForEachFilled([&](const long row, const long col, const int value) {
+        ASSERT_EQ(reference.at({row, col}), value);
+        ++visited;
+    });
+    ASSERT_EQ(visited, reference.size());
+
+    std::size_t chunk_cells{0U};
+    grid.ForEachChunk([&](const long origin_row, const long origin_col, const MatrixView<const int>& cells) {
+        ASSERT_EQ(origin_row % 16, 0);
+        ASSERT_EQ(origin_col % 16, 0);
+        chunk_cells += cells.NRows() * cells.NCols();
+    });
+    ASSERT_EQ(chunk_cells, grid.NChunks() * 16U * 16U);
+
+    // Round trip through a dense matrix
+    const SparseGrid<int, 16U> copy(grid.ToMatrix(), 0, grid.GetBoundingBox()->min_row,
+                                    grid.GetBoundingBox()->min_col);
+    ASSERT_EQ(copy.NFilled(), grid.NFilled());
+    ASSERT_EQ(copy.GetBoundingBox(), grid.GetBoundingBox());
+}
@@ -0,0 +1,122 @@
+/// @file data_structures_summed_area_table_tests.cpp
+/// @test commonlib::SummedAreaTable
+
+#include <vector>
+
+#include <data_structures/summed_area_table.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+// Sum of a rectangle (bounds included), by scanning
+template <typename T>
+static double Scan(const Matrix<T>& matrix, std::size_t r0, std::size_t c0, std::size_t r1, std::size_t c1)
+{
+    double sum{0.0};
+    for (std::size_t r{r0}; r <= r1; ++r)
+        for (std::size_t c{c0}; c <= c1; ++c)
+            sum += matrix(r, c);
+    return sum;
+}
+
+TEST(SummedAreaTableTests, QueriesTest)
+{
+    const Matrix<int> matrix({{1, 2, 3, 4}, {5, 6, 7, 8}, {9, 10, 11, 12}});
+    const SummedAreaTable<int> table(matrix);
+    ASSERT_EQ(table.NRows(), 3U);
+    ASSERT_EQ(table.Total(), 78);
+    ASSERT_EQ(table.Sum(1, 1, 2, 2), 6 + 7 + 10 + 11);
+    ASSERT_EQ(table.Sum(0, 3, 2, 3), 4 + 8 + 12);
+    ASSERT_EQ(table.At(2, 0), 9);
+    for (std::size_t r0{0U}; r0 < 3U; ++r0)
+        for (std::size_t c0{0U}; c0 < 4U; ++c0)
+            for (std::size_t r1{r0}; r1 < 3U; ++r1)
+                for (std::size_t c1{c0}; c1 < 4U; ++c1)
+                    ASSERT_EQ(table.Sum(r0, c0, r1, c1), Scan(matrix, r0, c0, r1, c1));
+
+    // Clamped and empty rectangles
+    ASSERT_EQ(table.Sum(1, 2, 100, 100), 7 + 8 + 11 + 12);
+    ASSERT_EQ(table.Sum(2, 0, 1, 3), 0);
+    ASSERT_EQ(table.Sum(5, 5, 6, 6), 0);
+    ASSERT_EQ(SummedAreaTable<int>().Total(), 0);
+
+    const SummedAreaTable<double> doubles(Matrix<double>({{0.5, 1.5}, {2.5, 3.5}}));
+    ASSERT_DOUBLE_EQ(doubles.Sum(0, 1, 1, 1), 5.0);
+}
+
+TEST(SummedAreaTableTests, UpdatesTest)
+{
+    Matrix<int> matrix(20U, 30U, 1);
+    SummedAreaTable<int> table(matrix);
+    table.SetPendingLimit(8U);
+    for (std::size_t i{0U}; i < 50U; ++i)
+    {
+        const std::size_t row{(i * 7U) % 20U};
+        const std::size_t col{(i * 13U) % 30U};
+        matrix(row, col) = static_cast<int>(i) - 25;
+        table.Set(row, col, static_cast<int>(i) - 25);
+        ASSERT_LE(table.NPending(), 8U);
+        ASSERT_EQ(table.Sum(2, 3, 17, 21), Scan(matrix, 2, 3, 17, 21));
+        ASSERT_EQ(table.Total(), Scan(matrix, 0, 0, 19, 29));
+    }
+    table.Add(0, 0, 10);
+    ASSERT_EQ(table.At(0, 0), matrix(0, 0) + 10);
+    table.Flush();
+    ASSERT_EQ(table.NPending(), 0U);
+    ASSERT_EQ(table.At(0, 0), matrix(0, 0) + 10);
+    ASSERT_THROW(table.Set(20, 0, 1), std::out_of_range);
+
+    // Unsigned elements: decreasing a value wraps around and back
+    Matrix<unsigned> counts(2U, 2U, 5U);
+    SummedAreaTable<unsigned> unsigned_table(counts);
+    unsigned_table.Set(1, 1, 2U);
+    ASSERT_EQ(unsigned_table.Total(), 17U);
+    unsigned_table.Flush();
+    ASSERT_EQ(unsigned_table.Total(), 17U);
+}
+
+TEST(SummedAreaTableTests, PendingTreeTest)
+{
+    // Many pending updates, never folded: the queries read them from the Fenwick tree
+    Matrix<long long> matrix(33U, 17U, 0);
+    SummedAreaTable<long long> table(matrix);
+    table.SetPendingLimit(100000U);
+    for (std::size_t i{0U}; i < 2000U; ++i)
+    {
+        const std::size_t row{(i * 7U) % 33U};
+        const std::size_t col{(i * 11U) % 17U};
+        matrix(row, col) += static_cast<long long>(i % 13U) - 6;
+        table.Add(row, col, static_cast<long long>(i % 13U) - 6);
+        if (i % 97U == 0U)
+        {
+            ASSERT_EQ(table.Sum(i % 33U, i % 17U, 32U, 16U), Scan(matrix, i % 33U, i % 17U, 32U, 16U));
+            ASSERT_EQ(table.Sum(0U, 0U, i % 33U, i % 17U), Scan(matrix, 0U, 0U, i % 33U, i % 17U));
+        }
+    }
+    ASSERT_EQ(table.NPending(), 2000U);
+    ASSERT_EQ(table.At(32U, 16U), matrix(32U, 16U));
+    ASSERT_THROW(table.At(33U, 0U), std::out_of_range);
+    table.Flush();
+    ASSERT_EQ(table.Total(), Scan(matrix, 0U, 0U, 32U, 16U));
+}
+
+TEST(SummedAreaTableTests, FlushDriftTest)
+{
+    // Folding the updates recomputes the prefix sums from the element values: no error accumulates across flushes
+    Matrix<double> matrix(64U, 64U, 0.1);
+    SummedAreaTable<double> table(matrix);
+    for (std::size_t i{0U}; i < 500U; ++i)
+    {
+        const std::size_t row{(i * 7U) % 64U};
+        const std::size_t col{(i * 13U) % 64U};
+        matrix(row, col) = 1e6 + 0.1 * static_cast<double>(i);
+        table.Set(row, col, matrix(row, col));
+        table.Flush();
+        matrix(row, col) = 0.1;
+        table.Set(row, col, 0.1);
+        table.Flush();
+    }
+    ASSERT_EQ(table.Total(), SummedAreaTable<double>(matrix).Total());
+    ASSERT_EQ(table.At(5U, 7U), 0.1);
+}
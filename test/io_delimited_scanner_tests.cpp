@@ -0,0 +1,71 @@
+/// @file io_delimited_scanner_tests.cpp
+/// @test commonlib::ScanDelimited
+
+#include <string>
+#include <vector>
+
+#include <io/delimited_scanner.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+typedef std::vector<std::vector<std::string>> Cells;
+
+static Cells Scan(const std::string& text, const char sep = ',')
+{
+    Cells cells(1);
+    ScanDelimited(
+        text.data(),
+        text.data() + text.size(),
+        sep,
+        [&cells](const char* begin, const char* end) { cells.back().emplace_back(begin, end); },
+        [&cells]() { cells.emplace_back(); });
+    cells.pop_back();
+    return cells;
+}
+
+TEST(DelimitedScannerTests, ShortTextTest)
+{
+    ASSERT_EQ(Scan("1,2,3\n4,5,6\n"), Cells({{"1", "2", "3"}, {"4", "5", "6"}}));
+    ASSERT_EQ(Scan("1,2\r\n\r\n\n3,4"), Cells({{"1", "2"}, {"3", "4"}}));
+    ASSERT_EQ(Scan("1,,3\n"), Cells({{"1", "", "3"}}));
+    ASSERT_EQ(Scan("a;b\n", ';'), Cells({{"a", "b"}}));
+    ASSERT_EQ(Scan(""), Cells());
+}
+
+TEST(DelimitedScannerTests, LongTextTest)
+{
+    // Long enough to go through the 64 bytes blocks, with delimiters on the block boundaries
+    std::string text;
+    Cells expected;
+    for (int row{0}; row < 20; ++row)
+    {
+        expected.emplace_back();
+        for (int col{0}; col < 17; ++col)
+        {
+            const std::string cell = std::to_string(row * 1000 + col * 7);
+            expected.back().push_back(cell);
+            text += cell + ((col < 16) ? "," : "\n");
+        }
+    }
+    ASSERT_EQ(Scan(text), expected);
+    ASSERT_EQ(CountChar(text.data(), text.data() + text.size(), '\n'), 20U);
+    ASSERT_EQ(CountChar(text.data(), text.data() + text.size(), ','), 20U * 16U);
+}
+
+TEST(DelimitedScannerTests, ParseCellTest)
+{
+    const std::string cells("42, -7 ,x,1.5,");
+    int value{0};
+    ASSERT_TRUE(ParseCell(cells.data(), cells.data() + 2, value));
+    ASSERT_EQ(value, 42);
+    ASSERT_TRUE(ParseCell(cells.data() + 3, cells.data() + 7, value));
+    ASSERT_EQ(value, -7);
+    ASSERT_FALSE(ParseCell(cells.data() + 8, cells.data() + 9, value));
+    ASSERT_FALSE(ParseCell(cells.data() + 10, cells.data() + 13, value));
+    ASSERT_FALSE(ParseCell(cells.data() + 14, cells.data() + 14, value));
+    float real{0.0F};
+    ASSERT_TRUE(ParseCell(cells.data() + 10, cells.data() + 13, real));
+    ASSERT_FLOAT_EQ(real, 1.5F);
+}
@@ -0,0 +1,96 @@
+/// @file io_row_reader_tests.cpp
+/// @test commonlib::MatrixRowReader
+
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include <io/row_reader.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+// Rows of 3 elements, element (r, c) is 10 * r + c
+static std::string TallMatrix(const std::size_t n_rows)
+{
+    std::string text;
+    for (std::size_t r{0U}; r < n_rows; ++r)
+        text += std::to_string(10 * r) + "," + std::to_string(10 * r + 1) + "," + std::to_string(10 * r + 2) + "\r\n";
+    return text;
+}
+
+TEST(MatrixRowReaderTests, BlocksTest)
+{
+    std::istringstream text(TallMatrix(1000));
+    MatrixRowReader<long> reader(text, ',', 64U);
+    ASSERT_EQ(reader.NCols(), 3U);
+    std::size_t n_blocks{0U};
+    long sum{0};
+    const std::size_t n_rows = reader.ForEachBlock(64U, [&](std::size_t first_row, MatrixView<const long> block) {
+        ASSERT_EQ(first_row, 64U * n_blocks++);
+        ASSERT_EQ(block(0, 2), static_cast<long>(10 * first_row + 2));
+        for (std::size_t r{0U}; r < block.NRows(); ++r)
+            for (std::size_t c{0U}; c < block.NCols(); ++c)
+                sum += block(r, c);
+    });
+    ASSERT_EQ(n_rows, 1000U);
+    ASSERT_EQ(n_blocks, 16U);
+    ASSERT_EQ(sum, 3L * 10L * 999L * 1000L / 2L + 3000L);
+    ASSERT_EQ(reader.RowsRead(), 1000U);
+
+    // Same result as the Matrix constructor
+    std::ifstream fp("data/input_matrix.txt");
+    MatrixRowReader<int> file_reader(fp);
+    Matrix<int> block(4U, 3U, 0);
+    ASSERT_EQ(file_reader.Read(block), 2U);
+    ASSERT_EQ(block.SubView(0, 0, 2, 3), std::vector<std::vector<int>>({{1, 2, 3}, {4, 5, 6}}));
+    ASSERT_EQ(file_reader.Read(block), 0U);
+    Matrix<int> wrong(1U, 2U);
+    ASSERT_THROW(file_reader.Read(wrong), std::length_error);
+}
+
+TEST(MatrixRowReaderTests, WindowsTest)
+{
+    std::istringstream text(TallMatrix(100));
+    MatrixRowReader<int> reader(text, ',', 16U);
+    std::size_t expected_row{0U};
+    const std::size_t n_windows = reader.ForEachWindow(5U, [&](std::size_t first_row, MatrixView<const int> window) {
+        ASSERT_EQ(first_row, expected_row++);
+        ASSERT_EQ(window.NRows(), 5U);
+        ASSERT_EQ(window(0, 0), static_cast<int>(10 * first_row));
+        ASSERT_EQ(window(4, 1), static_cast<int>(10 * (first_row + 4) + 1));
+    });
+    ASSERT_EQ(n_windows, 96U);
+
+    std::istringstream short_text("ab\ncd\n");
+    MatrixRowReader<char> chars(short_text, '\0');
+    ASSERT_EQ(chars.ForEachWindow(3U, [](std::size_t, MatrixView<const char>) {}), 0U);
+}
+
+TEST(MatrixRowReaderTests, ErrorsTest)
+{
+    std::istringstream empty("\n\n");
+    ASSERT_THROW(MatrixRowReader<int>{empty}, std::length_error);
+
+    std::istringstream ragged("1,2\n3,4\n5\n");
+    MatrixRowReader<int> ragged_reader(ragged);
+    ASSERT_THROW(ragged_reader.ForEachBlock(8U, [](std::size_t, MatrixView<const int>) {}), std::length_error);
+
+    std::istringstream malformed("1,2\n3,4\n5,x\n");
+    MatrixRowReader<int> malformed_reader(malformed, ',', 4U);
+    Matrix<int> block(1U, 2U);
+    ASSERT_EQ(malformed_reader.Read(block), 1U);
+    ASSERT_EQ(malformed_reader.Read(block), 1U);
+    try
+    {
+        malformed_reader.Read(block);
+        FAIL();
+    }
+    catch (const ParseError& e)
+    {
+        EXPECT_EQ(e.Row(), 2U);
+        EXPECT_EQ(e.Column(), 1U);
+    }
+}
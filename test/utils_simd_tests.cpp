@@ -0,0 +1,54 @@
+/// @file utils_simd_tests.cpp
+/// @test commonlib::simd
+
+#include <cstdint>
+#include <vector>
+
+#include <utils/simd.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+template <class T>
+struct SimdTests : public ::testing::Test
+{
+    // Long enough to go through the vector loops and the scalar tails
+    std::vector<T> MakeData() const
+    {
+        std::vector<T> data(131);
+        for (std::size_t i{0U}; i < data.size(); ++i)
+            data[i] = static_cast<T>((i % 7 == 3) ? 42 : (i % 5));
+        return data;
+    }
+};
+
+TYPED_TEST_CASE_P(SimdTests);
+TYPED_TEST_P(SimdTests, KernelsTest)
+{
+    auto data = this->MakeData();
+    const TypeParam needle = static_cast<TypeParam>(42);
+    std::vector<std::size_t> expected;
+    for (std::size_t i{0U}; i < data.size(); ++i)
+        if (data[i] == needle) expected.push_back(i);
+
+    ASSERT_EQ(simd::Count(data.data(), data.size(), needle), expected.size());
+    ASSERT_EQ(simd::FindFirst(data.data(), data.size(), needle), 3U);
+    ASSERT_EQ(simd::FindFirst(data.data(), data.size(), static_cast<TypeParam>(99)), data.size());
+
+    std::vector<std::size_t> found;
+    simd::ForEachMatch(data.data(), data.size(), needle, [&found](std::size_t i) { found.push_back(i); });
+    ASSERT_EQ(found, expected);
+
+    ASSERT_EQ(simd::Replace(data.data(), data.size(), needle, static_cast<TypeParam>(9)), expected.size());
+    ASSERT_EQ(simd::Count(data.data(), data.size(), needle), 0U);
+    ASSERT_EQ(data[3], static_cast<TypeParam>(9));
+    ASSERT_EQ(data[4], static_cast<TypeParam>(4));
+
+    simd::Fill(data.data(), data.size(), static_cast<TypeParam>(1));
+    ASSERT_EQ(simd::Count(data.data(), data.size(), static_cast<TypeParam>(1)), data.size());
+}
+REGISTER_TYPED_TEST_CASE_P(SimdTests, KernelsTest);
+
+typedef ::testing::Types<char, std::uint8_t, int, std::uint32_t, std::int64_t, float> SimdTypes;
+INSTANTIATE_TYPED_TEST_CASE_P(My, SimdTests, SimdTypes);
@@ -0,0 +1,38 @@
+/// @file utils_thread_pool_tests.cpp
+/// @test commonlib::ThreadPool
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include <utils/thread_pool.h>
+#include <gtest/gtest.h>
+
+using namespace testing;
+using namespace commonlib;
+
+TEST(ThreadPoolTests, SubmitTest)
+{
+    ThreadPool pool(3);
+    ASSERT_EQ(pool.Size(), 3U);
+    auto result = pool.Submit([]() { return 6 * 7; });
+    ASSERT_EQ(result.get(), 42);
+}
+
+TEST(ThreadPoolTests, ParallelForTest)
+{
+    ThreadPool pool(4);
+    std::vector<int> values(100, 0);
+    pool.ParallelFor(values.size(), [&values](std::size_t i) { values[i] = int(i) * 2; });
+    for (std::size_t i{0U}; i < values.size(); ++i)
+        ASSERT_EQ(values[i], int(i) * 2);
+
+    std::atomic<int> completed{0};
+    ASSERT_THROW(pool.ParallelFor(8,
+                                  [&completed](std::size_t i) {
+                                      if (i == 3) throw std::runtime_error("task failed");
+                                      ++completed;
+                                  }),
+                 std::runtime_error);
+    ASSERT_EQ(completed.load(), 7);
+}